@@ -0,0 +1,94 @@
+// Copyright 2024 Peter Dimov.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+// Measures the cost of starting a short hash from a seeded state,
+// either by copying it (as hash_append_unordered_range does per element)
+// or by calling reset() on a reused resettable<Hash>
+
+#include <boost/hash2/resettable.hpp>
+#include <boost/hash2/fnv1a.hpp>
+#include <boost/hash2/siphash.hpp>
+#include <boost/hash2/xxhash.hpp>
+#include <boost/hash2/md5.hpp>
+#include <boost/hash2/sha1.hpp>
+#include <boost/hash2/sha2.hpp>
+#include <boost/hash2/ripemd.hpp>
+#include <boost/hash2/get_integral_result.hpp>
+#include <boost/core/type_name.hpp>
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+
+template<class Hash> void test_( int M )
+{
+    typedef std::chrono::steady_clock clock_type;
+
+    Hash const h0( 0x0102030405060708ull );
+
+    unsigned r1 = 0;
+
+    clock_type::time_point t1 = clock_type::now();
+
+    for( int i = 0; i < M; ++i )
+    {
+        Hash h( h0 );
+
+        std::uint32_t v = static_cast<std::uint32_t>( i );
+        h.update( &v, sizeof(v) );
+
+        r1 += boost::hash2::get_integral_result<unsigned>( h.result() );
+    }
+
+    clock_type::time_point t2 = clock_type::now();
+
+    unsigned r2 = 0;
+
+    {
+        boost::hash2::resettable<Hash> h( h0 );
+
+        for( int i = 0; i < M; ++i )
+        {
+            h.reset();
+
+            std::uint32_t v = static_cast<std::uint32_t>( i );
+            h.update( &v, sizeof(v) );
+
+            r2 += boost::hash2::get_integral_result<unsigned>( h.result() );
+        }
+    }
+
+    clock_type::time_point t3 = clock_type::now();
+
+    long long ns1 = std::chrono::duration_cast<std::chrono::nanoseconds>( t2 - t1 ).count();
+    long long ns2 = std::chrono::duration_cast<std::chrono::nanoseconds>( t3 - t2 ).count();
+
+    std::printf( "%s (size %u, align %u): %u, %u: copy %.2f ns, reset %.2f ns\n",
+        boost::core::type_name<Hash>().c_str(), static_cast<unsigned>( sizeof(Hash) ), static_cast<unsigned>( alignof(Hash) ),
+        r1, r2, static_cast<double>( ns1 ) / M, static_cast<double>( ns2 ) / M );
+}
+
+int main()
+{
+    using namespace boost::hash2;
+
+    int const M = 4 * 1048576;
+
+    test_<fnv1a_32>( M );
+    test_<fnv1a_64>( M );
+    test_<xxhash_32>( M );
+    test_<xxhash_64>( M );
+    test_<siphash_32>( M );
+    test_<siphash_64>( M );
+    test_<md5_128>( M );
+    test_<sha1_160>( M );
+    test_<sha2_256>( M );
+    test_<sha2_224>( M );
+    test_<sha2_512>( M );
+    test_<sha2_384>( M );
+    test_<sha2_512_224>( M );
+    test_<sha2_512_256>( M );
+    test_<ripemd_160>( M );
+    test_<ripemd_128>( M );
+    test_<hmac_sha2_256>( M );
+}
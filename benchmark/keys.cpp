@@ -10,6 +10,7 @@
 #include <boost/hash2/md5.hpp>
 #include <boost/hash2/sha1.hpp>
 #include <boost/hash2/ripemd.hpp>
+#include <boost/hash2/sha2.hpp>
 #include <boost/hash2/hash_append.hpp>
 #include <boost/hash2/get_integral_result.hpp>
 #include <boost/core/type_name.hpp>
@@ -21,9 +22,21 @@
 #include <cstdio>
 #include <string>
 #include <vector>
+#include <cstring>
 
 #define STATIC_ASSERT(...) static_assert(__VA_ARGS__, #__VA_ARGS__)
 
+struct uuid
+{
+    unsigned char data[ 16 ];
+
+    template<class Hash, class Flavor>
+    friend void tag_invoke( boost::hash2::hash_append_tag const&, Hash& h, Flavor const& f, uuid const& v )
+    {
+        boost::hash2::hash_append( h, f, v.data );
+    }
+};
+
 template<class T, class H> class hasher
 {
 private:
@@ -74,7 +87,7 @@ template<class H, class V> void test3( int N, V const& v, std::size_t seed )
 
     std::size_t q = 0;
 
-    hasher<std::string, H> const h( seed );
+    hasher<typename V::value_type, H> const h( seed );
 
     for( int i = 0; i < N; ++i )
     {
@@ -86,8 +99,9 @@ template<class H, class V> void test3( int N, V const& v, std::size_t seed )
     long long ms1 = std::chrono::duration_cast<std::chrono::milliseconds>( t2 - t1 ).count();
 
     std::string hash = boost::core::type_name<H>();
+    std::string key = boost::core::type_name<typename V::value_type>();
 
-    std::printf( "%s: q=%zu, %lld ms\n", hash.c_str(), q, ms1 );
+    std::printf( "%s, %s: q=%zu, %lld ms\n", hash.c_str(), key.c_str(), q, ms1 );
 }
 
 template<class H, class V> void test2( int N, V const& v )
@@ -125,6 +139,31 @@ int main()
         }
     }
 
+    std::vector<std::uint64_t> v2;
+    std::vector<uuid> v3;
+
+    {
+        v2.reserve( N );
+        v3.reserve( N );
+
+        std::mt19937_64 rnd;
+
+        for( int i = 0; i < N; ++i )
+        {
+            std::uint64_t k1 = rnd();
+            std::uint64_t k2 = rnd();
+
+            v2.push_back( k1 );
+
+            uuid u;
+
+            std::memcpy( u.data + 0, &k1, 8 );
+            std::memcpy( u.data + 8, &k2, 8 );
+
+            v3.push_back( u );
+        }
+    }
+
     using namespace boost::hash2;
 
     test2<fnv1a_32>( N, v );
@@ -135,4 +174,18 @@ int main()
     test2<siphash_64>( N, v );
 
     std::puts( "" );
+
+    test2<fnv1a_64>( N, v2 );
+    test2<xxhash_64>( N, v2 );
+    test2<siphash_64>( N, v2 );
+    test2<sha2_256>( N, v2 );
+
+    std::puts( "" );
+
+    test2<fnv1a_64>( N, v3 );
+    test2<xxhash_64>( N, v3 );
+    test2<siphash_64>( N, v3 );
+    test2<sha2_256>( N, v3 );
+
+    std::puts( "" );
 }
@@ -4,7 +4,7 @@
 
 #include <boost/hash2/xxhash.hpp>
 #include <boost/hash2/digest.hpp>
-#include <boost/endian/conversion.hpp>
+#include <boost/hash2/result_into.hpp>
 
 class xxhash_128: private boost::hash2::xxhash_64
 {
@@ -17,13 +17,10 @@ public:
 
     result_type result()
     {
-        std::uint64_t r1 = xxhash_64::result();
-        std::uint64_t r2 = xxhash_64::result();
+        // two consecutive 64 bit results, in little endian order
 
         result_type r = {};
-
-        boost::endian::store_little_u64( r.data() + 0, r1 );
-        boost::endian::store_little_u64( r.data() + 8, r2 );
+        boost::hash2::result_into( static_cast<xxhash_64&>( *this ), r.data(), r.size() );
 
         return r;
     }
@@ -0,0 +1,187 @@
+#ifndef BOOST_HASH2_ASCII_CASE_INSENSITIVE_HPP_INCLUDED
+#define BOOST_HASH2_ASCII_CASE_INSENSITIVE_HPP_INCLUDED
+
+// Copyright 2024 Peter Dimov.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/hash2/hash_append.hpp>
+#include <boost/hash2/hasher.hpp>
+#include <boost/hash2/get_integral_result.hpp>
+#include <boost/hash2/flavor.hpp>
+#include <boost/hash2/detail/read.hpp>
+#include <boost/hash2/detail/write.hpp>
+#include <type_traits>
+#include <string>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+
+namespace boost
+{
+namespace hash2
+{
+
+namespace detail
+{
+
+BOOST_CXX14_CONSTEXPR unsigned char ascii_lower( unsigned char ch )
+{
+    return ch >= 'A' && ch <= 'Z'? static_cast<unsigned char>( ch + 0x20 ): ch;
+}
+
+// lowercases the ASCII letters in eight bytes at once; no carries
+// cross byte boundaries, so the byte order of w doesn't matter
+
+BOOST_CXX14_CONSTEXPR std::uint64_t ascii_lower( std::uint64_t w )
+{
+    std::uint64_t const H = 0x8080808080808080ull;
+    std::uint64_t const L = 0x0101010101010101ull;
+
+    std::uint64_t const h7 = w & ~H;
+
+    std::uint64_t const ge_A = h7 + ( 0x80 - 'A' ) * L; // high bit set when >= 'A'
+    std::uint64_t const gt_Z = h7 + ( 0x7F - 'Z' ) * L; // high bit set when > 'Z'
+
+    std::uint64_t const upper = ( ge_A ^ gt_Z ) & ~w & H;
+
+    return w | ( upper >> 2 );
+}
+
+// the characters of a std::string compatible argument
+
+template<class S> std::pair<char const*, std::size_t> string_ref_( S const& s, std::true_type )
+{
+    return { s.data(), s.size() };
+}
+
+inline std::pair<char const*, std::size_t> string_ref_( char const* s, std::false_type )
+{
+    return { s, std::char_traits<char>::length( s ) };
+}
+
+template<class S> std::pair<char const*, std::size_t> string_ref( S const& s )
+{
+    return detail::string_ref_( s, std::is_void< c_string_char<S> >() );
+}
+
+} // namespace detail
+
+// hash_append_ascii_lower
+
+template<class Hash, class Flavor = default_flavor>
+void hash_append_ascii_lower( Hash& h, Flavor const& f, char const* p, std::size_t n )
+{
+    // the characters are lowercased into a stack buffer, a chunk at a time
+
+    constexpr std::size_t N = 64;
+    unsigned char buffer[ N ];
+
+    for( std::size_t i = 0; i < n; i += N )
+    {
+        std::size_t k = n - i < N? n - i: N;
+        unsigned char const* q = reinterpret_cast<unsigned char const*>( p + i );
+
+        std::size_t j = 0;
+
+        for( ; j + 8 <= k; j += 8 )
+        {
+            detail::write64le( buffer + j, detail::ascii_lower( detail::read64le( q + j ) ) );
+        }
+
+        for( ; j < k; ++j )
+        {
+            buffer[ j ] = detail::ascii_lower( q[ j ] );
+        }
+
+        h.update( buffer, k );
+    }
+
+    hash2::hash_append_size( h, f, n );
+}
+
+template<class Hash, class Flavor = default_flavor, class S>
+typename std::enable_if< is_hash_compatible<std::string, S>::value >::type
+    hash_append_ascii_lower( Hash& h, Flavor const& f, S const& s )
+{
+    std::pair<char const*, std::size_t> r = detail::string_ref( s );
+    hash2::hash_append_ascii_lower( h, f, r.first, r.second );
+}
+
+// ascii_case_insensitive_hasher
+
+template<class H, class Flavor = default_flavor> class ascii_case_insensitive_hasher
+{
+public:
+
+    using hash_type = H;
+    using flavor_type = Flavor;
+
+    using is_avalanching = std::true_type;
+    using is_transparent = void;
+
+private:
+
+    hash_type h_;
+
+public:
+
+    ascii_case_insensitive_hasher(): h_()
+    {
+    }
+
+    explicit ascii_case_insensitive_hasher( std::uint64_t seed ): h_( seed )
+    {
+    }
+
+    ascii_case_insensitive_hasher( unsigned char const* p, std::size_t n ): h_( p, n )
+    {
+    }
+
+    template<class S>
+        typename std::enable_if< is_hash_compatible<std::string, S>::value, std::size_t >::type
+        operator()( S const& s ) const
+    {
+        hash_type h( h_ );
+        hash2::hash_append_ascii_lower( h, flavor_type(), s );
+        return hash2::get_integral_result<std::size_t>( h.result() );
+    }
+};
+
+// ascii_case_insensitive_equal_to
+
+struct ascii_case_insensitive_equal_to
+{
+    using is_transparent = void;
+
+private:
+
+    static bool equal( std::pair<char const*, std::size_t> r1, std::pair<char const*, std::size_t> r2 )
+    {
+        if( r1.second != r2.second ) return false;
+
+        for( std::size_t i = 0; i < r1.second; ++i )
+        {
+            unsigned char c1 = static_cast<unsigned char>( r1.first[ i ] );
+            unsigned char c2 = static_cast<unsigned char>( r2.first[ i ] );
+
+            if( detail::ascii_lower( c1 ) != detail::ascii_lower( c2 ) ) return false;
+        }
+
+        return true;
+    }
+
+public:
+
+    template<class S1, class S2>
+        typename std::enable_if< is_hash_compatible<std::string, S1>::value && is_hash_compatible<std::string, S2>::value, bool >::type
+        operator()( S1 const& s1, S2 const& s2 ) const
+    {
+        return equal( detail::string_ref( s1 ), detail::string_ref( s2 ) );
+    }
+};
+
+} // namespace hash2
+} // namespace boost
+
+#endif // #ifndef BOOST_HASH2_ASCII_CASE_INSENSITIVE_HPP_INCLUDED
@@ -0,0 +1,92 @@
+#ifndef BOOST_HASH2_CACHED_HASH_HPP_INCLUDED
+#define BOOST_HASH2_CACHED_HASH_HPP_INCLUDED
+
+// Copyright 2024 Peter Dimov.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/hash2/hash_append.hpp>
+#include <boost/hash2/flavor.hpp>
+#include <utility>
+
+namespace boost
+{
+namespace hash2
+{
+
+// an immutable value along with its digest under H and Flavor;
+// hash_append of a cached_hash appends the digest
+//
+// the digest is computed by a copy of an H that can be seeded; values
+// that are compared or hashed together must use the same seed
+
+template<class T, class H, class Flavor = default_flavor> class cached_hash
+{
+public:
+
+    using value_type = T;
+    using hash_type = H;
+    using flavor_type = Flavor;
+    using result_type = typename H::result_type;
+
+private:
+
+    value_type value_;
+    result_type digest_;
+
+    static result_type compute_digest( hash_type h, value_type const& v )
+    {
+        hash2::hash_append( h, flavor_type(), v );
+        return h.result();
+    }
+
+public:
+
+    explicit cached_hash( value_type const& v ): value_( v ), digest_( compute_digest( hash_type(), value_ ) )
+    {
+    }
+
+    explicit cached_hash( value_type&& v ): value_( std::move( v ) ), digest_( compute_digest( hash_type(), value_ ) )
+    {
+    }
+
+    cached_hash( value_type const& v, hash_type const& h0 ): value_( v ), digest_( compute_digest( h0, value_ ) )
+    {
+    }
+
+    cached_hash( value_type&& v, hash_type const& h0 ): value_( std::move( v ) ), digest_( compute_digest( h0, value_ ) )
+    {
+    }
+
+    value_type const& value() const noexcept
+    {
+        return value_;
+    }
+
+    result_type const& digest() const noexcept
+    {
+        return digest_;
+    }
+
+    // the digests are compared first, as a fast rejection
+
+    friend bool operator==( cached_hash const& a, cached_hash const& b )
+    {
+        return a.digest_ == b.digest_ && a.value_ == b.value_;
+    }
+
+    friend bool operator!=( cached_hash const& a, cached_hash const& b )
+    {
+        return !( a == b );
+    }
+
+    template<class Hash, class F> friend void tag_invoke( hash_append_tag const&, Hash& h, F const& f, cached_hash const& v )
+    {
+        hash2::hash_append( h, f, v.digest_ );
+    }
+};
+
+} // namespace hash2
+} // namespace boost
+
+#endif // #ifndef BOOST_HASH2_CACHED_HASH_HPP_INCLUDED
@@ -0,0 +1,179 @@
+#ifndef BOOST_HASH2_DETAIL_BLOCK_STATE_HPP_INCLUDED
+#define BOOST_HASH2_DETAIL_BLOCK_STATE_HPP_INCLUDED
+
+// Copyright 2024 Peter Dimov.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/hash2/detail/read.hpp>
+#include <boost/hash2/detail/write.hpp>
+#include <boost/hash2/detail/memset.hpp>
+#include <boost/assert.hpp>
+#include <boost/config.hpp>
+#include <type_traits>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+
+namespace boost
+{
+namespace hash2
+{
+namespace detail
+{
+
+// Serialized state of a Merkle-Damgard block hash:
+//
+//   [ 0]     format version (block_state_version)
+//   [ 1]     algorithm id
+//   [ 2, 8)  zero
+//   [ 8,16)  message length in bytes, little endian
+//   [16, .)  chaining words, little endian
+//   [ ., .)  block buffer; bytes past the message length % N are zero
+
+constexpr unsigned char block_state_version = 1;
+
+// gives resettable access to the chaining words and the message length
+struct reset_access;
+
+// H supports export_state/import_state
+
+template<class H, class En = void> struct has_state_export: std::false_type
+{
+};
+
+template<class H> struct has_state_export<H, decltype(
+    std::declval<H const&>().export_state( std::declval<unsigned char*>() ),
+    (void)std::declval<H&>().import_state( std::declval<unsigned char const*>() ),
+    (void)H::state_size,
+    void())>: std::true_type
+{
+};
+
+constexpr unsigned char block_state_md5_128 = 1;
+constexpr unsigned char block_state_sha1_160 = 2;
+constexpr unsigned char block_state_sha2_256 = 3;
+constexpr unsigned char block_state_sha2_224 = 4;
+constexpr unsigned char block_state_sha2_512 = 5;
+constexpr unsigned char block_state_sha2_384 = 6;
+constexpr unsigned char block_state_sha2_512_224 = 7;
+constexpr unsigned char block_state_sha2_512_256 = 8;
+constexpr unsigned char block_state_ripemd_128 = 9;
+constexpr unsigned char block_state_ripemd_160 = 10;
+
+template<class Word, std::size_t W, std::size_t N> struct block_state_size
+{
+    static constexpr std::size_t value = 16 + W * sizeof( Word ) + N;
+};
+
+BOOST_FORCEINLINE BOOST_CXX14_CONSTEXPR void write_state_word( unsigned char* p, std::uint32_t v )
+{
+    detail::write32le( p, v );
+}
+
+BOOST_FORCEINLINE BOOST_CXX14_CONSTEXPR void write_state_word( unsigned char* p, std::uint64_t v )
+{
+    detail::write64le( p, v );
+}
+
+BOOST_FORCEINLINE BOOST_CXX14_CONSTEXPR void read_state_word( unsigned char const* p, std::uint32_t& v )
+{
+    v = detail::read32le( p );
+}
+
+BOOST_FORCEINLINE BOOST_CXX14_CONSTEXPR void read_state_word( unsigned char const* p, std::uint64_t& v )
+{
+    v = detail::read64le( p );
+}
+
+template<class Word, std::size_t W, std::size_t N>
+BOOST_CXX14_CONSTEXPR void export_block_state( unsigned char* p, unsigned char id, Word const (&state)[ W ], unsigned char const (&buffer)[ N ], std::uint64_t n )
+{
+    p[ 0 ] = block_state_version;
+    p[ 1 ] = id;
+
+    for( int i = 2; i < 8; ++i )
+    {
+        p[ i ] = 0;
+    }
+
+    detail::write64le( p + 8, n );
+    p += 16;
+
+    for( std::size_t i = 0; i < W; ++i )
+    {
+        detail::write_state_word( p, state[ i ] );
+        p += sizeof( Word );
+    }
+
+    for( std::size_t i = 0; i < N; ++i )
+    {
+        p[ i ] = buffer[ i ];
+    }
+}
+
+// leaves the outputs unchanged and returns false when the header
+// doesn't match or the unused part of the buffer isn't zero
+
+template<class Word, std::size_t W, std::size_t N>
+BOOST_CXX14_CONSTEXPR bool import_block_state( unsigned char const* p, unsigned char id, Word (&state)[ W ], unsigned char (&buffer)[ N ], std::uint64_t& n )
+{
+    if( p[ 0 ] != block_state_version || p[ 1 ] != id )
+    {
+        return false;
+    }
+
+    for( int i = 2; i < 8; ++i )
+    {
+        if( p[ i ] != 0 ) return false;
+    }
+
+    std::uint64_t const n2 = detail::read64le( p + 8 );
+
+    unsigned char const* q = p + 16 + W * sizeof( Word );
+
+    for( std::size_t i = n2 % N; i < N; ++i )
+    {
+        if( q[ i ] != 0 ) return false;
+    }
+
+    n = n2;
+    p += 16;
+
+    for( std::size_t i = 0; i < W; ++i )
+    {
+        detail::read_state_word( p, state[ i ] );
+        p += sizeof( Word );
+    }
+
+    for( std::size_t i = 0; i < N; ++i )
+    {
+        buffer[ i ] = q[ i ];
+    }
+
+    return true;
+}
+
+// returns to the state after n0 bytes, a multiple of N, with the chaining
+// words w; as the buffer is zero past n % N, only the bytes before are cleared
+
+template<class Word, std::size_t W, std::size_t N>
+BOOST_CXX14_CONSTEXPR void rewind_block_state( Word (&state)[ W ], unsigned char (&buffer)[ N ], std::uint64_t& n, Word const (&w)[ W ], std::uint64_t n0 )
+{
+    BOOST_ASSERT( n0 % N == 0 );
+
+    detail::memset( buffer, 0, static_cast<std::size_t>( n % N ) );
+
+    for( std::size_t i = 0; i < W; ++i )
+    {
+        state[ i ] = w[ i ];
+    }
+
+    n = n0;
+}
+
+} // namespace detail
+} // namespace hash2
+} // namespace boost
+
+#endif // #ifndef BOOST_HASH2_DETAIL_BLOCK_STATE_HPP_INCLUDED
@@ -0,0 +1,55 @@
+#ifndef BOOST_HASH2_DETAIL_HMAC_SHA2_256_HPP_INCLUDED
+#define BOOST_HASH2_DETAIL_HMAC_SHA2_256_HPP_INCLUDED
+
+// Copyright 2024 Peter Dimov
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+// HMAC-SHA-256 of 32 byte messages on the lanes of sha2_256d.hpp. After
+// the key block, such a message and the inner digest each fill a single
+// pre-padded block, so an HMAC is two compressions from the key states
+
+#include <boost/hash2/hmac.hpp>
+#include <boost/hash2/sha2.hpp>
+#include <boost/hash2/sha2_256d.hpp>
+#include <boost/hash2/detail/read.hpp>
+#include <cstdint>
+#include <cstddef>
+
+namespace boost
+{
+namespace hash2
+{
+namespace detail
+{
+
+// the bit length of the inner and outer messages, one key block and 32 bytes
+constexpr std::uint32_t hmac_sha2_256_32_bits = 8 * ( 64 + 32 );
+
+// loads the inner and outer states of key into lane l
+
+template<std::size_t L> void hmac_sha2_256_load_lanes( hmac_key<sha2_256> const& key, sha2_256_lanes_state<L>& inner, sha2_256_lanes_state<L>& outer, std::size_t l )
+{
+    unsigned char const* p = hmac_key_access::inner_words( key );
+    unsigned char const* q = hmac_key_access::outer_words( key );
+
+    for( int i = 0; i < 8; ++i )
+    {
+        inner.st[ i ][ l ] = detail::read32le( p + i * 4 );
+        outer.st[ i ][ l ] = detail::read32le( q + i * 4 );
+    }
+}
+
+// replaces each lane of s, a 32 byte message, with its HMAC
+
+template<std::size_t L> void hmac_sha2_256_32_lanes( sha2_256_lanes_state<L>& s, sha2_256_lanes_state<L> const& inner, sha2_256_lanes_state<L> const& outer )
+{
+    sha2_256_32_lanes( s, inner, hmac_sha2_256_32_bits );
+    sha2_256_32_lanes( s, outer, hmac_sha2_256_32_bits );
+}
+
+} // namespace detail
+} // namespace hash2
+} // namespace boost
+
+#endif // #ifndef BOOST_HASH2_DETAIL_HMAC_SHA2_256_HPP_INCLUDED
@@ -0,0 +1,111 @@
+#ifndef BOOST_HASH2_DETAIL_PARALLEL_INVOKE_HPP_INCLUDED
+#define BOOST_HASH2_DETAIL_PARALLEL_INVOKE_HPP_INCLUDED
+
+// Copyright 2024 Peter Dimov
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+// parallel_invoke creates and joins its threads on every call. A thread
+// pool would need either global state or an executor parameter on every
+// function that uses it, so instead the callers limit the number of
+// threads, e.g. with thread_count_for, to give each one enough work to
+// amortize its creation, which costs tens of microseconds; smaller
+// inputs are processed on the calling thread
+
+#include <thread>
+#include <vector>
+#include <exception>
+#include <cstddef>
+
+namespace boost
+{
+namespace hash2
+{
+namespace detail
+{
+
+inline std::size_t default_thread_count() noexcept
+{
+    unsigned k = std::thread::hardware_concurrency();
+    return k == 0? 1: k;
+}
+
+// the number of threads for n units of work, at most `threads` (0 means
+// default_thread_count()), such that each gets at least min_per_thread units
+
+inline std::size_t thread_count_for( std::size_t n, std::size_t min_per_thread, std::size_t threads ) noexcept
+{
+    if( threads == 0 )
+    {
+        threads = default_thread_count();
+    }
+
+    std::size_t const k = n / min_per_thread;
+
+    if( threads > k )
+    {
+        threads = k;
+    }
+
+    return threads == 0? 1: threads;
+}
+
+// calls f(i) for i in [0, k), with f(0) on the calling thread
+// and the rest on separate threads; rethrows the first exception
+
+template<class F> void parallel_invoke( std::size_t k, F const& f )
+{
+    if( k == 0 ) return;
+
+    std::vector<std::exception_ptr> ex( k );
+
+    auto run = [&f, &ex]( std::size_t i ){
+
+        try
+        {
+            f( i );
+        }
+        catch( ... )
+        {
+            ex[ i ] = std::current_exception();
+        }
+
+    };
+
+    std::vector<std::thread> th;
+    th.reserve( k - 1 );
+
+    for( std::size_t i = 1; i < k; ++i )
+    {
+        try
+        {
+            th.emplace_back( run, i );
+        }
+        catch( ... )
+        {
+            // thread creation failed, run on the calling thread
+            run( i );
+        }
+    }
+
+    run( 0 );
+
+    for( std::size_t i = 0; i < th.size(); ++i )
+    {
+        th[ i ].join();
+    }
+
+    for( std::size_t i = 0; i < k; ++i )
+    {
+        if( ex[ i ] )
+        {
+            std::rethrow_exception( ex[ i ] );
+        }
+    }
+}
+
+} // namespace detail
+} // namespace hash2
+} // namespace boost
+
+#endif // #ifndef BOOST_HASH2_DETAIL_PARALLEL_INVOKE_HPP_INCLUDED
@@ -0,0 +1,392 @@
+#ifndef BOOST_HASH2_FASTCDC_HPP_INCLUDED
+#define BOOST_HASH2_FASTCDC_HPP_INCLUDED
+
+// Copyright 2024 Peter Dimov.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+// FastCDC content-defined chunking with normalized chunking
+// https://www.usenix.org/conference/atc16/technical-sessions/presentation/xia
+
+#include <boost/hash2/rolling_hash.hpp>
+#include <boost/throw_exception.hpp>
+#include <boost/config.hpp>
+#include <vector>
+#include <stdexcept>
+#include <cstdint>
+#include <cstddef>
+
+namespace boost
+{
+namespace hash2
+{
+
+// a chunk of the stream, [offset, offset+size), and its digest
+
+template<class H> struct fastcdc_chunk
+{
+    std::uint64_t offset;
+    std::size_t size;
+
+    typename H::result_type digest;
+};
+
+template<> struct fastcdc_chunk<void>
+{
+    std::uint64_t offset;
+    std::size_t size;
+};
+
+namespace detail
+{
+
+template<class H> class fastcdc_digest
+{
+private:
+
+    H h_;
+
+public:
+
+    void update( unsigned char const* p, std::size_t n )
+    {
+        h_.update( p, n );
+    }
+
+    void store( fastcdc_chunk<H>& c )
+    {
+        c.digest = h_.result();
+        h_ = H();
+    }
+
+    void reset()
+    {
+        h_ = H();
+    }
+};
+
+template<> class fastcdc_digest<void>
+{
+public:
+
+    void update( unsigned char const* /*p*/, std::size_t /*n*/ )
+    {
+    }
+
+    void store( fastcdc_chunk<void>& /*c*/ )
+    {
+    }
+
+    void reset()
+    {
+    }
+};
+
+} // namespace detail
+
+template<class H = void> class fastcdc
+{
+public:
+
+    using hash_type = H;
+    using chunk = fastcdc_chunk<H>;
+
+    static constexpr std::size_t default_min_size = 2048;
+    static constexpr std::size_t default_avg_size = 8192;
+    static constexpr std::size_t default_max_size = 65536;
+
+private:
+
+    // the number of mask bits added before, and removed after, avg_size
+    static constexpr int normalization = 2;
+
+    gear_64 gear_;
+
+    std::size_t min_;
+    std::size_t avg_;
+    std::size_t max_;
+
+    std::uint64_t mask_s_; // for chunk sizes below avg_size; harder to match
+    std::uint64_t mask_l_; // for chunk sizes from avg_size on
+
+    std::uint64_t fp_ = 0;
+
+    std::uint64_t offset_ = 0; // the offset of the current chunk
+    std::size_t len_ = 0;      // the number of bytes in the current chunk
+
+    detail::fastcdc_digest<H> digest_;
+
+    std::vector<chunk> chunks_;
+
+private:
+
+    // k bits, at the top, where they depend on all of the last 64 bytes
+    static std::uint64_t mask_( int k ) noexcept
+    {
+        return ~std::uint64_t( 0 ) << ( 64 - k );
+    }
+
+    void init_()
+    {
+        if( !( 0 < min_ && min_ <= avg_ && avg_ <= max_ ) )
+        {
+            BOOST_THROW_EXCEPTION( std::invalid_argument( "fastcdc: sizes must satisfy 0 < min_size <= avg_size <= max_size" ) );
+        }
+
+        // mask_s_ has log2( avg_ ) + normalization bits, at most 64
+
+        if( static_cast<std::uint64_t>( avg_ ) >= ( std::uint64_t( 1 ) << 62 ) )
+        {
+            BOOST_THROW_EXCEPTION( std::invalid_argument( "fastcdc: avg_size must be less than 2^62" ) );
+        }
+
+        int bits = 0;
+
+        while( ( std::size_t( 2 ) << bits ) <= avg_ )
+        {
+            ++bits;
+        }
+
+        // bits == floor( log2( avg_ ) )
+
+        mask_s_ = mask_( bits + normalization );
+        mask_l_ = mask_( bits > normalization? bits - normalization: 1 );
+    }
+
+    // hashes the bytes p[i], i in [first, last), until ( fp & mask ) == 0;
+    // returns the index after the matching byte, or last if none matches
+
+    std::size_t match_( unsigned char const* p, std::size_t first, std::size_t last, std::uint64_t mask, std::uint64_t& fp, bool& cut ) const
+    {
+        std::uint64_t h = fp;
+        std::size_t i = first;
+
+        // two bytes per iteration; the hash after the second byte
+        // doesn't depend on the one after the first, which shortens
+        // the dependency chain
+
+        for( ; last - i >= 2; i += 2 )
+        {
+            std::uint64_t a = gear_.table( p[ i ] );
+            std::uint64_t b = gear_.table( p[ i + 1 ] );
+
+            std::uint64_t h1 = ( h << 1 ) + a;
+            std::uint64_t h2 = ( h << 2 ) + ( a << 1 ) + b;
+
+            if( BOOST_UNLIKELY( ( ( h1 & mask ) == 0 ) | ( ( h2 & mask ) == 0 ) ) )
+            {
+                cut = true;
+
+                if( ( h1 & mask ) == 0 )
+                {
+                    fp = h1;
+                    return i + 1;
+                }
+                else
+                {
+                    fp = h2;
+                    return i + 2;
+                }
+            }
+
+            h = h2;
+        }
+
+        if( i < last )
+        {
+            h = ( h << 1 ) + gear_.table( p[ i ] );
+            ++i;
+
+            if( ( h & mask ) == 0 )
+            {
+                cut = true;
+            }
+        }
+
+        fp = h;
+        return i;
+    }
+
+    // returns the number of bytes in [p, p+n) that belong to the
+    // current chunk; sets cut to true when the chunk ends there
+
+    std::size_t find_( unsigned char const* p, std::size_t n, bool& cut )
+    {
+        cut = false;
+
+        std::size_t i = 0;
+
+        // no boundary can occur before min_size, so these bytes aren't hashed
+
+        if( len_ < min_ )
+        {
+            i = min_ - len_;
+
+            if( i > n )
+            {
+                return n;
+            }
+        }
+
+        std::size_t const end1 = avg_ > len_ + i? avg_ - len_: i;
+        std::size_t const end2 = max_ - len_;
+
+        i = match_( p, i, end1 < n? end1: n, mask_s_, fp_, cut );
+
+        if( cut ) return i;
+
+        i = match_( p, i, end2 < n? end2: n, mask_l_, fp_, cut );
+
+        if( cut ) return i;
+
+        if( i == end2 )
+        {
+            // max_size reached
+            cut = true;
+        }
+
+        return i;
+    }
+
+    void emit_()
+    {
+        chunk c;
+
+        c.offset = offset_;
+        c.size = len_;
+
+        digest_.store( c );
+        chunks_.push_back( c );
+
+        offset_ += len_;
+        len_ = 0;
+        fp_ = 0;
+    }
+
+public:
+
+    fastcdc(): fastcdc( default_min_size, default_avg_size, default_max_size )
+    {
+    }
+
+    explicit fastcdc( std::uint64_t seed ): fastcdc( seed, default_min_size, default_avg_size, default_max_size )
+    {
+    }
+
+    fastcdc( unsigned char const* p, std::size_t n ): fastcdc( p, n, default_min_size, default_avg_size, default_max_size )
+    {
+    }
+
+    fastcdc( std::size_t min_size, std::size_t avg_size, std::size_t max_size ):
+        min_( min_size ), avg_( avg_size ), max_( max_size )
+    {
+        init_();
+    }
+
+    fastcdc( std::uint64_t seed, std::size_t min_size, std::size_t avg_size, std::size_t max_size ):
+        gear_( seed ), min_( min_size ), avg_( avg_size ), max_( max_size )
+    {
+        init_();
+    }
+
+    fastcdc( unsigned char const* p, std::size_t n, std::size_t min_size, std::size_t avg_size, std::size_t max_size ):
+        gear_( p, n ), min_( min_size ), avg_( avg_size ), max_( max_size )
+    {
+        init_();
+    }
+
+    std::size_t min_size() const noexcept
+    {
+        return min_;
+    }
+
+    std::size_t avg_size() const noexcept
+    {
+        return avg_;
+    }
+
+    std::size_t max_size() const noexcept
+    {
+        return max_;
+    }
+
+    // appends [p, p+n) to the stream; the chunks that end in it
+    // are added to chunks(), each with the digest of its bytes
+
+    void update( unsigned char const* p, std::size_t n )
+    {
+        while( n > 0 )
+        {
+            bool cut = false;
+            std::size_t k = find_( p, n, cut );
+
+            digest_.update( p, k );
+            len_ += k;
+
+            p += k;
+            n -= k;
+
+            if( cut )
+            {
+                emit_();
+            }
+        }
+    }
+
+    void update( void const* pv, std::size_t n )
+    {
+        unsigned char const* p = static_cast<unsigned char const*>( pv );
+        update( p, n );
+    }
+
+    // ends the stream; the remaining bytes, if any, form the last chunk
+    void finish()
+    {
+        if( len_ > 0 )
+        {
+            emit_();
+        }
+    }
+
+    // the number of bytes passed to update()
+    std::uint64_t size() const noexcept
+    {
+        return offset_ + len_;
+    }
+
+    // the chunks found since the last clear_chunks(), in stream order
+    std::vector<chunk> const& chunks() const noexcept
+    {
+        return chunks_;
+    }
+
+    void clear_chunks() noexcept
+    {
+        chunks_.clear();
+    }
+
+    // starts a new stream, with the same parameters and seed
+    void reset()
+    {
+        fp_ = 0;
+        offset_ = 0;
+        len_ = 0;
+
+        digest_.reset();
+        chunks_.clear();
+    }
+};
+
+#if defined(BOOST_NO_CXX17_INLINE_VARIABLES)
+
+template<class H> constexpr std::size_t fastcdc<H>::default_min_size;
+template<class H> constexpr std::size_t fastcdc<H>::default_avg_size;
+template<class H> constexpr std::size_t fastcdc<H>::default_max_size;
+template<class H> constexpr int fastcdc<H>::normalization;
+
+#endif
+
+} // namespace hash2
+} // namespace boost
+
+#endif // #ifndef BOOST_HASH2_FASTCDC_HPP_INCLUDED
@@ -51,6 +51,18 @@ public:
 
     BOOST_CXX14_CONSTEXPR explicit fnv1a( std::uint64_t seed )
     {
+        reseed( seed );
+    }
+
+    BOOST_CXX14_CONSTEXPR fnv1a( unsigned char const * p, std::size_t n )
+    {
+        reseed( p, n );
+    }
+
+    BOOST_CXX14_CONSTEXPR void reseed( std::uint64_t seed )
+    {
+        st_ = fnv1a_const<T>::basis;
+
         if( seed )
         {
             unsigned char tmp[ 8 ] = {};
@@ -59,8 +71,10 @@ public:
         }
     }
 
-    BOOST_CXX14_CONSTEXPR fnv1a( unsigned char const * p, std::size_t n )
+    BOOST_CXX14_CONSTEXPR void reseed( unsigned char const * p, std::size_t n )
     {
+        st_ = fnv1a_const<T>::basis;
+
         if( n != 0 )
         {
             update( p, n );
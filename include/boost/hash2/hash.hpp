@@ -0,0 +1,63 @@
+#ifndef BOOST_HASH2_HASH_HPP_INCLUDED
+#define BOOST_HASH2_HASH_HPP_INCLUDED
+
+// Copyright 2024 Peter Dimov.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/config.hpp>
+#include <type_traits>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+
+namespace boost
+{
+namespace hash2
+{
+
+namespace detail
+{
+
+// H::hash( p, n, seed ), a one-shot function reading directly from [p, p+n)
+
+template<class H, class = void> struct has_one_shot_hash: std::false_type
+{
+};
+
+template<class H> struct has_one_shot_hash<H, decltype( (void)H::hash( std::declval<unsigned char const*>(), std::size_t(), std::uint64_t() ) )>: std::true_type
+{
+};
+
+template<class H>
+BOOST_CXX14_CONSTEXPR typename std::enable_if< has_one_shot_hash<H>::value, typename H::result_type >::type
+    hash( unsigned char const* p, std::size_t n, std::uint64_t seed )
+{
+    return H::hash( p, n, seed );
+}
+
+template<class H>
+BOOST_CXX14_CONSTEXPR typename std::enable_if< !has_one_shot_hash<H>::value, typename H::result_type >::type
+    hash( unsigned char const* p, std::size_t n, std::uint64_t seed )
+{
+    H h( seed );
+    h.update( p, n );
+    return h.result();
+}
+
+} // namespace detail
+
+template<class H> BOOST_CXX14_CONSTEXPR typename H::result_type hash( unsigned char const* p, std::size_t n, std::uint64_t seed = 0 )
+{
+    return detail::hash<H>( p, n, seed );
+}
+
+template<class H> typename H::result_type hash( void const* p, std::size_t n, std::uint64_t seed = 0 )
+{
+    return detail::hash<H>( static_cast<unsigned char const*>( p ), n, seed );
+}
+
+} // namespace hash2
+} // namespace boost
+
+#endif // #ifndef BOOST_HASH2_HASH_HPP_INCLUDED
@@ -14,6 +14,7 @@
 #include <boost/hash2/hash_append_fwd.hpp>
 #include <boost/hash2/is_contiguously_hashable.hpp>
 #include <boost/hash2/has_constant_size.hpp>
+#include <boost/hash2/range_segments.hpp>
 #include <boost/hash2/get_integral_result.hpp>
 #include <boost/hash2/flavor.hpp>
 #include <boost/hash2/detail/is_constant_evaluated.hpp>
@@ -32,11 +33,14 @@
 #include <cstdint>
 #include <type_traits>
 #include <iterator>
+#include <bitset>
+#include <cstring>
 
 namespace boost
 {
 
 template<class T, std::size_t N> class array;
+template<class Block, class Allocator> class dynamic_bitset;
 
 namespace hash2
 {
@@ -171,6 +175,50 @@ struct hash_append_tag
 namespace detail
 {
 
+// fixed size update, h.update<N>( p ), when supported by Hash
+
+template<class Hash, std::size_t N, class En = void> struct has_fixed_update: std::false_type
+{
+};
+
+template<class Hash, std::size_t N> struct has_fixed_update<Hash, N, decltype(
+    std::declval<Hash&>().template update<N>( std::declval<unsigned char const*>() ),
+    void())>: std::true_type
+{
+};
+
+template<std::size_t N, class Hash>
+    BOOST_CXX14_CONSTEXPR
+    typename std::enable_if< has_fixed_update<Hash, N>::value, void >::type
+    update_fixed( Hash& h, unsigned char const* p )
+{
+    h.template update<N>( p );
+}
+
+template<std::size_t N, class Hash>
+    BOOST_CXX14_CONSTEXPR
+    typename std::enable_if< !has_fixed_update<Hash, N>::value, void >::type
+    update_fixed( Hash& h, unsigned char const* p )
+{
+    h.update( p, N );
+}
+
+// not constexpr, used only outside of constant evaluation
+
+template<class Hash, class T>
+    typename std::enable_if< has_fixed_update<Hash, sizeof(T)>::value, void >::type
+    update_object( Hash& h, T const& v )
+{
+    h.template update<sizeof(T)>( reinterpret_cast<unsigned char const*>( &v ) );
+}
+
+template<class Hash, class T>
+    typename std::enable_if< !has_fixed_update<Hash, sizeof(T)>::value, void >::type
+    update_object( Hash& h, T const& v )
+{
+    h.update( &v, sizeof(T) );
+}
+
 // integral types
 
 template<class Hash, class Flavor, class T>
@@ -183,7 +231,7 @@ template<class Hash, class Flavor, class T>
     unsigned char tmp[ N ] = {};
     detail::write( v, Flavor::byte_order, tmp );
 
-    h.update( tmp, N );
+    detail::update_fixed<N>( h, tmp );
 }
 
 // enum types
@@ -241,6 +289,128 @@ template<class Hash, class Flavor, class T, std::size_t N> BOOST_CXX14_CONSTEXPR
     hash2::hash_append_range( h, f, v + 0, v + N );
 }
 
+// words, serialized in the byte order requested by the flavor and passed
+// to update in chunks rather than one at a time
+
+template<class Hash, class Flavor, class W> class word_writer
+{
+private:
+
+    static constexpr std::size_t N = 64;
+
+    Hash& h_;
+
+    unsigned char buffer_[ N * sizeof(W) ];
+    std::size_t n_ = 0;
+
+public:
+
+    explicit word_writer( Hash& h ): h_( h )
+    {
+    }
+
+    word_writer( word_writer const& ) = delete;
+    word_writer& operator=( word_writer const& ) = delete;
+
+    void push( W w )
+    {
+        unsigned char tmp[ sizeof(W) ] = {};
+        detail::write( w, Flavor::byte_order, tmp );
+
+        std::memcpy( buffer_ + n_ * sizeof(W), tmp, sizeof(W) );
+
+        if( ++n_ == N ) flush();
+    }
+
+    void flush()
+    {
+        if( n_ != 0 )
+        {
+            h_.update( buffer_, n_ * sizeof(W) );
+            n_ = 0;
+        }
+    }
+
+    // output iterator, for boost::to_block_range
+
+    struct iterator
+    {
+        using iterator_category = std::output_iterator_tag;
+        using value_type = void;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = void;
+
+        word_writer* p_;
+
+        iterator& operator*() { return *this; }
+        iterator& operator++() { return *this; }
+        iterator& operator++( int ) { return *this; }
+
+        iterator& operator=( W w )
+        {
+            p_->push( w );
+            return *this;
+        }
+    };
+};
+
+// std::bitset, as a sequence of 64 bit words, low bits first; constant size
+// never constexpr
+
+template<class Hash, class Flavor, std::size_t N> void do_hash_append( Hash& h, Flavor const& f, std::bitset<N> const& v )
+{
+    if( N == 0 )
+    {
+        // A hash_append call must always result in a call to Hash::update
+        hash2::hash_append( h, f, '\x00' );
+        return;
+    }
+
+    detail::word_writer<Hash, Flavor, std::uint64_t> w( h );
+
+    if( N <= 64 )
+    {
+        w.push( v.to_ullong() );
+    }
+    else
+    {
+        // the words are assembled from the bits; shifting the whole
+        // bitset once per word, as to_ullong requires, is quadratic in N
+
+        for( std::size_t i = 0; i < N; i += 64 )
+        {
+            std::size_t const k = N - i < 64? N - i: 64;
+
+            std::uint64_t x = 0;
+
+            for( std::size_t j = 0; j < k; ++j )
+            {
+                x |= static_cast<std::uint64_t>( v[ i + j ] ) << j;
+            }
+
+            w.push( x );
+        }
+    }
+
+    w.flush();
+}
+
+// boost::dynamic_bitset, as a sequence of blocks, w/ size
+// never constexpr
+
+template<class Hash, class Flavor, class Block, class Allocator> void do_hash_append( Hash& h, Flavor const& f, boost::dynamic_bitset<Block, Allocator> const& v )
+{
+    detail::word_writer<Hash, Flavor, Block> w( h );
+
+    typename detail::word_writer<Hash, Flavor, Block>::iterator it = { &w };
+    to_block_range( v, it );
+
+    w.flush();
+
+    hash2::hash_append_size( h, f, v.size() );
+}
+
 // contiguous containers and ranges, w/ size
 
 template<class Hash, class Flavor, class T>
@@ -252,16 +422,48 @@ template<class Hash, class Flavor, class T>
     hash2::hash_append_size( h, f, v.size() );
 }
 
+// segmented containers and ranges of contiguously hashable elements
+
+template<class T, class Flavor, class En = void> struct is_segmented_range_: std::false_type
+{
+};
+
+template<class T, class Flavor> struct is_segmented_range_<T, Flavor, typename std::enable_if< has_range_segments<T>::value >::type>:
+    is_contiguously_hashable<typename T::value_type, Flavor::byte_order>
+{
+};
+
 // containers and ranges, w/ size
 
 template<class Hash, class Flavor, class T>
     BOOST_CXX14_CONSTEXPR
-    typename std::enable_if< container_hash::is_range<T>::value && !has_constant_size<T>::value && !container_hash::is_contiguous_range<T>::value && !container_hash::is_unordered_range<T>::value, void >::type
+    typename std::enable_if< container_hash::is_range<T>::value && !has_constant_size<T>::value && !container_hash::is_contiguous_range<T>::value && !container_hash::is_unordered_range<T>::value && !is_segmented_range_<T, Flavor>::value, void >::type
     do_hash_append( Hash& h, Flavor const& f, T const& v )
 {
     hash2::hash_append_sized_range( h, f, v.begin(), v.end() );
 }
 
+// segmented containers and ranges, w/ size; each segment is passed to update
+// as a whole, which is equivalent to passing the elements one at a time
+
+template<class Hash, class Flavor, class T>
+    typename std::enable_if< container_hash::is_range<T>::value && !has_constant_size<T>::value && !container_hash::is_contiguous_range<T>::value && !container_hash::is_unordered_range<T>::value && is_segmented_range_<T, Flavor>::value, void >::type
+    do_hash_append( Hash& h, Flavor const& f, T const& v )
+{
+    using U = typename T::value_type;
+
+    std::size_t m = 0;
+
+    range_segments<T>::for_each( v, [&]( U const* p, std::size_t n ){
+
+        h.update( p, n * sizeof(U) );
+        m += n;
+
+    });
+
+    hash2::hash_append_size( h, f, m );
+}
+
 #if defined(BOOST_MSVC)
 # pragma warning(push)
 # pragma warning(disable: 4702) // unreachable code
@@ -412,7 +614,7 @@ BOOST_CXX14_CONSTEXPR void hash_append( Hash& h, Flavor const& f, T const& v )
 {
     if( !detail::is_constant_evaluated() && is_contiguously_hashable<T, Flavor::byte_order>::value )
     {
-        h.update( &v, sizeof(T) );
+        detail::update_object( h, v );
     }
     else
     {
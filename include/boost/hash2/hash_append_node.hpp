@@ -0,0 +1,210 @@
+#ifndef BOOST_HASH2_HASH_APPEND_NODE_HPP_INCLUDED
+#define BOOST_HASH2_HASH_APPEND_NODE_HPP_INCLUDED
+
+// Copyright 2024 Peter Dimov.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/hash2/hash_append.hpp>
+#include <boost/hash2/flavor.hpp>
+#include <unordered_map>
+#include <type_traits>
+#include <functional>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+
+namespace boost
+{
+namespace hash2
+{
+
+namespace detail
+{
+
+// a unique address per type, so that a node and its first member,
+// which share an address, have distinct cache entries
+
+template<class T> struct node_type_id
+{
+    static constexpr char id = 0;
+};
+
+template<class T> constexpr char node_type_id<T>::id;
+
+} // namespace detail
+
+// node_digest_cache
+
+template<class H> class node_digest_cache
+{
+public:
+
+    using hash_type = H;
+    using result_type = typename H::result_type;
+
+private:
+
+    struct key_type
+    {
+        void const* p;
+        void const* t;
+
+        bool operator==( key_type const& rhs ) const noexcept
+        {
+            return p == rhs.p && t == rhs.t;
+        }
+    };
+
+    struct key_hash
+    {
+        std::size_t operator()( key_type const& k ) const noexcept
+        {
+            std::hash<void const*> hf;
+            return hf( k.p ) ^ ( hf( k.t ) + 0x9E3779B9u + ( hf( k.p ) << 6 ) + ( hf( k.p ) >> 2 ) );
+        }
+    };
+
+    template<class T> static key_type make_key( T const& node ) noexcept
+    {
+        return { std::addressof( node ), &detail::node_type_id<T>::id };
+    }
+
+    // the digests are computed by copies of h0_, so they depend on its seed
+
+    H h0_;
+
+    std::unordered_map<key_type, result_type, key_hash> map_;
+
+public:
+
+    node_digest_cache() = default;
+
+    explicit node_digest_cache( std::uint64_t seed ): h0_( seed )
+    {
+    }
+
+    node_digest_cache( unsigned char const* p, std::size_t n ): h0_( p, n )
+    {
+    }
+
+    explicit node_digest_cache( H const& h0 ): h0_( h0 )
+    {
+    }
+
+    H const& prototype() const noexcept
+    {
+        return h0_;
+    }
+
+    template<class T> result_type const* find( T const& node ) const
+    {
+        auto it = map_.find( make_key( node ) );
+        return it == map_.end()? nullptr: &it->second;
+    }
+
+    template<class T> void insert( T const& node, result_type const& r )
+    {
+        map_.insert( { make_key( node ), r } );
+    }
+
+    // must be called when a node is modified or destroyed
+
+    template<class T> bool erase( T const& node )
+    {
+        return map_.erase( make_key( node ) ) != 0;
+    }
+
+    void clear() noexcept
+    {
+        map_.clear();
+    }
+
+    std::size_t size() const noexcept
+    {
+        return map_.size();
+    }
+};
+
+// memoizing_flavor
+
+// the node digests are computed by copies of prototype, or of the
+// prototype of the cache, so that a seeded h doesn't make them unkeyed
+
+template<class H, class Flavor = default_flavor> struct memoizing_flavor: Flavor
+{
+    node_digest_cache<H>* cache;
+    H prototype;
+
+    memoizing_flavor(): cache( nullptr ), prototype()
+    {
+    }
+
+    explicit memoizing_flavor( node_digest_cache<H>& c ): cache( &c ), prototype( c.prototype() )
+    {
+    }
+
+    explicit memoizing_flavor( std::uint64_t seed ): cache( nullptr ), prototype( seed )
+    {
+    }
+
+    memoizing_flavor( unsigned char const* p, std::size_t n ): cache( nullptr ), prototype( p, n )
+    {
+    }
+
+    explicit memoizing_flavor( H const& h0 ): cache( nullptr ), prototype( h0 )
+    {
+    }
+};
+
+// hash_append_node
+
+namespace detail
+{
+
+template<class Hash, class Flavor, class T> typename Hash::result_type node_digest( Hash const& h0, Flavor const& f, T const& node )
+{
+    Hash h( h0 );
+    hash2::hash_append( h, f, node );
+    return h.result();
+}
+
+template<class Hash, class Flavor, class T> typename Hash::result_type memoized_node_digest( Flavor const& f, T const& node )
+{
+    return detail::node_digest( Hash(), f, node );
+}
+
+template<class Hash, class H, class F, class T> typename Hash::result_type memoized_node_digest( memoizing_flavor<H, F> const& f, T const& node )
+{
+    static_assert( std::is_same<Hash, H>::value, "The hash algorithm of memoizing_flavor must match the one used for hashing" );
+
+    if( f.cache == nullptr )
+    {
+        return detail::node_digest( f.prototype, f, node );
+    }
+
+    if( typename Hash::result_type const* p = f.cache->find( node ) )
+    {
+        return *p;
+    }
+
+    // the cache may be modified by the recursive calls, so the digest
+    // is computed first and inserted afterwards
+
+    typename Hash::result_type r = detail::node_digest( f.cache->prototype(), f, node );
+    f.cache->insert( node, r );
+
+    return r;
+}
+
+} // namespace detail
+
+template<class Hash, class Flavor, class T> void hash_append_node( Hash& h, Flavor const& f, T const& node )
+{
+    hash2::hash_append( h, f, detail::memoized_node_digest<Hash>( f, node ) );
+}
+
+} // namespace hash2
+} // namespace boost
+
+#endif // #ifndef BOOST_HASH2_HASH_APPEND_NODE_HPP_INCLUDED
@@ -0,0 +1,99 @@
+#ifndef BOOST_HASH2_HASH_APPEND_PAR_HPP_INCLUDED
+#define BOOST_HASH2_HASH_APPEND_PAR_HPP_INCLUDED
+
+// Copyright 2024 Peter Dimov.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/hash2/hash_append.hpp>
+#include <boost/hash2/get_integral_result.hpp>
+#include <boost/hash2/flavor.hpp>
+#include <boost/hash2/detail/parallel_invoke.hpp>
+#include <vector>
+#include <iterator>
+#include <cstdint>
+#include <cstddef>
+
+namespace boost
+{
+namespace hash2
+{
+
+namespace detail
+{
+
+// fewer elements than this per thread are hashed on the calling thread
+constexpr std::size_t unordered_range_par_min_elements = 4096;
+
+} // namespace detail
+
+// hash_append_unordered_range_par
+
+template<class Hash, class Flavor = default_flavor, class It>
+void hash_append_unordered_range_par( Hash& h, Flavor const& f, It first, It last, std::size_t threads = 0 )
+{
+    auto const m = std::distance( first, last );
+
+    std::size_t const n = static_cast<std::size_t>( m );
+
+    threads = detail::thread_count_for( n, detail::unordered_range_par_min_elements, threads );
+
+    if( threads <= 1 )
+    {
+        hash2::hash_append_unordered_range( h, f, first, last );
+        return;
+    }
+
+    // partition [first, last) into `threads` subranges of nearly equal size
+
+    std::vector<It> bounds;
+    bounds.reserve( threads + 1 );
+
+    bounds.push_back( first );
+
+    for( std::size_t i = 0; i < threads; ++i )
+    {
+        It it = bounds.back();
+        std::advance( it, n / threads + ( i < n % threads? 1: 0 ) );
+
+        bounds.push_back( it );
+    }
+
+    // the combination step is a sum modulo 2^64, so the partial sums
+    // can be computed independently and added in any order
+
+    std::vector<std::uint64_t> w( threads );
+
+    Hash const& h0 = h;
+
+    detail::parallel_invoke( threads, [&]( std::size_t i ){
+
+        std::uint64_t s = 0;
+
+        for( It it = bounds[ i ]; it != bounds[ i + 1 ]; ++it )
+        {
+            Hash h2( h0 );
+            hash2::hash_append( h2, f, *it );
+
+            s += hash2::get_integral_result<std::uint64_t>( h2.result() );
+        }
+
+        w[ i ] = s;
+
+    });
+
+    std::uint64_t s = 0;
+
+    for( std::size_t i = 0; i < threads; ++i )
+    {
+        s += w[ i ];
+    }
+
+    hash2::hash_append( h, f, s );
+    hash2::hash_append_size( h, f, m );
+}
+
+} // namespace hash2
+} // namespace boost
+
+#endif // #ifndef BOOST_HASH2_HASH_APPEND_PAR_HPP_INCLUDED
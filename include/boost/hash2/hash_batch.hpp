@@ -0,0 +1,74 @@
+#ifndef BOOST_HASH2_HASH_BATCH_HPP_INCLUDED
+#define BOOST_HASH2_HASH_BATCH_HPP_INCLUDED
+
+// Copyright 2024 Peter Dimov.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/hash2/hash_append.hpp>
+#include <boost/hash2/get_integral_result.hpp>
+#include <boost/hash2/flavor.hpp>
+#include <type_traits>
+#include <iterator>
+#include <cstdint>
+#include <cstddef>
+
+namespace boost
+{
+namespace hash2
+{
+
+namespace detail
+{
+
+// output an integral value as if by get_integral_result
+
+template<class V, class R>
+    typename std::enable_if< std::is_integral<V>::value && !std::is_same<V, R>::value, V >::type
+    hash_batch_result( R const& r )
+{
+    return hash2::get_integral_result<V>( r );
+}
+
+// output the result_type value unchanged
+
+template<class V, class R>
+    typename std::enable_if< !std::is_integral<V>::value || std::is_same<V, R>::value, R const& >::type
+    hash_batch_result( R const& r )
+{
+    return r;
+}
+
+} // namespace detail
+
+template<class H, class Flavor = default_flavor, class It, class Out>
+Out hash_batch( H const& h, Flavor const& f, It first, It last, Out out )
+{
+    using V = typename std::iterator_traits<Out>::value_type;
+
+    // the keys are independent, so successive iterations already
+    // overlap in the processor; keeping several states live at
+    // once, in rounds, measured slower than this loop
+
+    for( ; first != last; ++first )
+    {
+        H h2( h );
+        hash2::hash_append( h2, f, *first );
+
+        *out = detail::hash_batch_result<V>( h2.result() );
+        ++out;
+    }
+
+    return out;
+}
+
+template<class H, class It, class Out>
+Out hash_batch( std::uint64_t seed, It first, It last, Out out )
+{
+    return hash2::hash_batch( H( seed ), default_flavor(), first, last, out );
+}
+
+} // namespace hash2
+} // namespace boost
+
+#endif // #ifndef BOOST_HASH2_HASH_BATCH_HPP_INCLUDED
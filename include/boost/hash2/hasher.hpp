@@ -0,0 +1,210 @@
+#ifndef BOOST_HASH2_HASHER_HPP_INCLUDED
+#define BOOST_HASH2_HASHER_HPP_INCLUDED
+
+// Copyright 2024 Peter Dimov.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/hash2/hash_append.hpp>
+#include <boost/hash2/get_integral_result.hpp>
+#include <boost/hash2/has_constant_size.hpp>
+#include <boost/hash2/flavor.hpp>
+#include <boost/container_hash/is_contiguous_range.hpp>
+#include <type_traits>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+namespace boost
+{
+namespace hash2
+{
+
+// select_hash_t
+
+template<class H1, class H2 = H1> using select_hash_t = typename std::conditional<
+    sizeof(typename H1::result_type) == sizeof(std::size_t), H1, H2
+>::type;
+
+namespace detail
+{
+
+// contiguous ranges of variable size are hashed as their elements
+// followed by the size, so two such ranges with the same value_type
+// produce the same message
+
+template<class T, class E = void> struct is_sized_contiguous_range: std::false_type
+{
+};
+
+template<class T> struct is_sized_contiguous_range<T, typename std::enable_if<
+    container_hash::is_contiguous_range<T>::value && !has_constant_size<T>::value
+>::type>: std::true_type
+{
+};
+
+// the character type of a null-terminated string, or void
+
+template<class T> struct is_char_type: std::false_type
+{
+};
+
+template<> struct is_char_type<char>: std::true_type
+{
+};
+
+template<> struct is_char_type<wchar_t>: std::true_type
+{
+};
+
+template<> struct is_char_type<char16_t>: std::true_type
+{
+};
+
+template<> struct is_char_type<char32_t>: std::true_type
+{
+};
+
+#if defined(__cpp_char8_t) && __cpp_char8_t >= 201811L
+
+template<> struct is_char_type<char8_t>: std::true_type
+{
+};
+
+#endif
+
+template<class T> struct c_string_char_
+{
+    using type = void;
+};
+
+template<class Ch> struct c_string_char_<Ch*>
+{
+    using type = typename std::conditional<is_char_type<typename std::remove_const<Ch>::type>::value, typename std::remove_const<Ch>::type, void>::type;
+};
+
+template<class Ch, std::size_t N> struct c_string_char_<Ch[N]>: c_string_char_<Ch*>
+{
+};
+
+template<class T> using c_string_char = typename c_string_char_<typename std::remove_const<T>::type>::type;
+
+template<class T, class U, class E = void> struct is_hash_compatible_: std::false_type
+{
+};
+
+template<class T, class U> struct is_hash_compatible_<T, U, typename std::enable_if<
+    is_sized_contiguous_range<T>::value && is_sized_contiguous_range<U>::value
+>::type>: std::is_same<typename T::value_type, typename U::value_type>
+{
+};
+
+template<class T, class U> struct is_hash_compatible_<T, U, typename std::enable_if<
+    is_sized_contiguous_range<T>::value && !std::is_void< c_string_char<U> >::value
+>::type>: std::is_same<typename T::value_type, c_string_char<U>>
+{
+};
+
+} // namespace detail
+
+// is_hash_compatible<T, U>: hasher<T, H> gives the same hash value for
+// values of T and U that compare equal. This isn't true of hash_append
+// for C strings; hash_append( h, f, char const* ) hashes the pointer, and
+// only hasher treats a pointer to a character type as a string
+
+template<class T, class U> struct is_hash_compatible: detail::is_hash_compatible_<T, U>
+{
+};
+
+template<class T> struct is_hash_compatible<T, T>: std::true_type
+{
+};
+
+namespace detail
+{
+
+// hasher<T>::is_transparent is only present when T has compatible types
+
+template<class T, class E = void> struct hasher_transparent_base
+{
+};
+
+template<class T> struct hasher_transparent_base<T, typename std::enable_if<
+    is_sized_contiguous_range<T>::value
+>::type>
+{
+    using is_transparent = void;
+};
+
+} // namespace detail
+
+template<class T, class H, class Flavor = default_flavor> class hasher: public detail::hasher_transparent_base<T>
+{
+public:
+
+    using hash_type = H;
+    using flavor_type = Flavor;
+
+    using is_avalanching = std::true_type;
+
+private:
+
+    // the seeded initial state; byte seeds are processed once, here,
+    // and every call only copies the resulting state
+
+    hash_type h_;
+
+    template<class U> std::size_t hash_value( U const& v ) const
+    {
+        hash_type h( h_ );
+        hash2::hash_append( h, flavor_type(), v );
+        return hash2::get_integral_result<std::size_t>( h.result() );
+    }
+
+    template<class U> std::size_t hash_compatible( U const& v, std::true_type ) const
+    {
+        return hash_value( v );
+    }
+
+    // null-terminated strings are hashed as a string of the same characters
+
+    template<class Ch> std::size_t hash_compatible( Ch const* p, std::false_type ) const
+    {
+        std::size_t n = std::char_traits<Ch>::length( p );
+
+        hash_type h( h_ );
+        hash2::hash_append_sized_range( h, flavor_type(), p, p + n );
+        return hash2::get_integral_result<std::size_t>( h.result() );
+    }
+
+public:
+
+    hasher(): h_()
+    {
+    }
+
+    explicit hasher( std::uint64_t seed ): h_( seed )
+    {
+    }
+
+    hasher( unsigned char const* p, std::size_t n ): h_( p, n )
+    {
+    }
+
+    std::size_t operator()( T const& v ) const
+    {
+        return hash_value( v );
+    }
+
+    template<class U>
+        typename std::enable_if< is_hash_compatible<T, U>::value && !std::is_same<U, T>::value, std::size_t >::type
+        operator()( U const& v ) const
+    {
+        return hash_compatible( v, std::is_void< detail::c_string_char<U> >() );
+    }
+};
+
+} // namespace hash2
+} // namespace boost
+
+#endif // #ifndef BOOST_HASH2_HASHER_HPP_INCLUDED
@@ -0,0 +1,115 @@
+#ifndef BOOST_HASH2_HKDF_HPP_INCLUDED
+#define BOOST_HASH2_HKDF_HPP_INCLUDED
+
+// Copyright 2024 Peter Dimov.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+//
+// HKDF key derivation function, https://www.rfc-editor.org/rfc/rfc5869
+
+#include <boost/hash2/hmac.hpp>
+#include <boost/hash2/detail/memcpy.hpp>
+#include <boost/throw_exception.hpp>
+#include <stdexcept>
+#include <cstddef>
+
+namespace boost
+{
+namespace hash2
+{
+
+template<class H> struct hkdf
+{
+    using hash_type = H;
+    using result_type = typename hmac<H>::result_type;
+
+    // HashLen
+    static constexpr std::size_t hash_size = sizeof( result_type );
+
+    // the maximum output length of expand
+    static constexpr std::size_t max_size = 255 * hash_size;
+
+    static result_type extract( unsigned char const* salt, std::size_t sn, unsigned char const* ikm, std::size_t n )
+    {
+        // an empty salt is equivalent to HashLen zero bytes, as
+        // HMAC pads the key with zeroes to the block size
+
+        hmac<H> h( salt, sn );
+
+        if( n != 0 )
+        {
+            h.update( ikm, n );
+        }
+
+        return h.result();
+    }
+
+    static void expand( unsigned char const* prk, std::size_t pn, unsigned char const* info, std::size_t in, unsigned char* out, std::size_t n )
+    {
+        if( n > max_size )
+        {
+            BOOST_THROW_EXCEPTION( std::length_error( "hkdf: output length exceeds 255 * HashLen" ) );
+        }
+
+        // the PRK is processed once; each block starts from a copy
+        //
+        // hmac_key<H> isn't used here; it keeps only the chaining words,
+        // and restoring them goes through import_state, which costs more
+        // than copying the two H objects, at most 255 times
+
+        hmac<H> const h0( prk, pn );
+
+        result_type t = {};
+
+        for( std::size_t i = 1; n != 0; ++i )
+        {
+            hmac<H> h( h0 );
+
+            if( i > 1 )
+            {
+                h.update( t.data(), t.size() );
+            }
+
+            if( in != 0 )
+            {
+                h.update( info, in );
+            }
+
+            unsigned char c = static_cast<unsigned char>( i );
+            h.update( &c, 1 );
+
+            t = h.result();
+
+            std::size_t k = n < t.size()? n: t.size();
+
+            detail::memcpy( out, t.data(), k );
+
+            out += k;
+            n -= k;
+        }
+    }
+
+    static void expand( result_type const& prk, unsigned char const* info, std::size_t in, unsigned char* out, std::size_t n )
+    {
+        expand( prk.data(), prk.size(), info, in, out, n );
+    }
+
+    static void derive( unsigned char const* salt, std::size_t sn, unsigned char const* ikm, std::size_t kn, unsigned char const* info, std::size_t in, unsigned char* out, std::size_t n )
+    {
+        if( n > max_size )
+        {
+            BOOST_THROW_EXCEPTION( std::length_error( "hkdf: output length exceeds 255 * HashLen" ) );
+        }
+
+        result_type const prk = extract( salt, sn, ikm, kn );
+        expand( prk, info, in, out, n );
+    }
+};
+
+template<class H> constexpr std::size_t hkdf<H>::hash_size;
+template<class H> constexpr std::size_t hkdf<H>::max_size;
+
+} // namespace hash2
+} // namespace boost
+
+#endif // #ifndef BOOST_HASH2_HKDF_HPP_INCLUDED
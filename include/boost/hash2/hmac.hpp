@@ -9,9 +9,12 @@
 
 #include <boost/hash2/detail/write.hpp>
 #include <boost/hash2/detail/memcpy.hpp>
+#include <boost/hash2/detail/block_state.hpp>
 #include <boost/assert.hpp>
 #include <boost/config.hpp>
 #include <boost/config/workaround.hpp>
+#include <type_traits>
+#include <utility>
 #include <cstdint>
 #include <cstring>
 #include <cstddef>
@@ -35,6 +38,121 @@ namespace boost
 namespace hash2
 {
 
+template<class H> class hmac;
+template<class H> class hmac_key;
+
+namespace detail
+{
+
+// gives pbkdf2 and hmac_batch access to the key states
+struct hmac_key_access;
+
+// the inner and outer states of an HMAC after the key block
+
+template<class H, bool E = has_state_export<H>::value> class hmac_key_state
+{
+private:
+
+    H inner_;
+    H outer_;
+
+public:
+
+    BOOST_CXX14_CONSTEXPR void store( H const& inner, H const& outer )
+    {
+        inner_ = inner;
+        outer_ = outer;
+    }
+
+    BOOST_CXX14_CONSTEXPR void load( H& inner, H& outer ) const
+    {
+        inner = inner_;
+        outer = outer_;
+    }
+
+    BOOST_CXX14_CONSTEXPR void load_inner( H& inner ) const
+    {
+        inner = inner_;
+    }
+};
+
+// for block hashes, only the chaining words are kept; the message length
+// is always one block and the block buffer is empty
+
+template<class H> class hmac_key_state<H, true>
+{
+private:
+
+    static constexpr std::size_t S = H::state_size;
+    static constexpr std::size_t W = S - 16 - H::block_size;
+
+    unsigned char id_ = 0;
+
+    unsigned char inner_[ W ] = {};
+    unsigned char outer_[ W ] = {};
+
+private:
+
+    static BOOST_CXX14_CONSTEXPR void store_( H const& h, unsigned char& id, unsigned char (&w)[ W ] )
+    {
+        unsigned char tmp[ S ] = {};
+        h.export_state( tmp );
+
+        BOOST_ASSERT( detail::read64le( tmp + 8 ) == static_cast<std::uint64_t>( H::block_size ) );
+
+        id = tmp[ 1 ];
+        detail::memcpy( w, tmp + 16, W );
+    }
+
+    BOOST_CXX14_CONSTEXPR void load_( H& h, unsigned char const (&w)[ W ] ) const
+    {
+        unsigned char tmp[ S ] = {};
+
+        tmp[ 0 ] = detail::block_state_version;
+        tmp[ 1 ] = id_;
+
+        detail::write64le( tmp + 8, H::block_size );
+        detail::memcpy( tmp + 16, w, W );
+
+        bool r = h.import_state( tmp );
+
+        BOOST_ASSERT( r ); (void)r;
+    }
+
+public:
+
+    BOOST_CXX14_CONSTEXPR void store( H const& inner, H const& outer )
+    {
+        store_( inner, id_, inner_ );
+        store_( outer, id_, outer_ );
+    }
+
+    BOOST_CXX14_CONSTEXPR void load( H& inner, H& outer ) const
+    {
+        load_( inner, inner_ );
+        load_( outer, outer_ );
+    }
+
+    BOOST_CXX14_CONSTEXPR void load_inner( H& inner ) const
+    {
+        load_( inner, inner_ );
+    }
+
+    // the chaining words, little endian, as exported
+
+    BOOST_CXX14_CONSTEXPR unsigned char const* inner_words() const noexcept
+    {
+        return inner_;
+    }
+
+    BOOST_CXX14_CONSTEXPR unsigned char const* outer_words() const noexcept
+    {
+        return outer_;
+    }
+};
+
+} // namespace detail
+
 template<class H> class hmac
 {
 public:
@@ -44,6 +162,9 @@ public:
 
 private:
 
+    friend class hmac_key<H>;
+    friend struct detail::reset_access;
+
     H outer_;
     H inner_;
 
@@ -115,6 +236,21 @@ public:
         init( p, n );
     }
 
+    explicit BOOST_CXX14_CONSTEXPR hmac( hmac_key<H> const& key )
+    {
+        key.st_.load( inner_, outer_ );
+    }
+
+    BOOST_HASH2_HMAC_CONSTEXPR void reseed( std::uint64_t seed )
+    {
+        *this = hmac( seed );
+    }
+
+    BOOST_HASH2_HMAC_CONSTEXPR void reseed( unsigned char const* p, std::size_t n )
+    {
+        *this = hmac( p, n );
+    }
+
     BOOST_CXX14_CONSTEXPR void update( unsigned char const* p, std::size_t n )
     {
         inner_.update( p, n );
@@ -135,6 +271,70 @@ public:
     }
 };
 
+template<class H> class hmac_key
+{
+private:
+
+    friend class hmac<H>;
+    friend struct detail::hmac_key_access;
+
+    detail::hmac_key_state<H> st_;
+
+    BOOST_HASH2_HMAC_CONSTEXPR void init( hmac<H> const& h )
+    {
+        st_.store( h.inner_, h.outer_ );
+    }
+
+public:
+
+    using hash_type = H;
+
+    BOOST_HASH2_HMAC_CONSTEXPR hmac_key()
+    {
+        init( hmac<H>() );
+    }
+
+    explicit BOOST_HASH2_HMAC_CONSTEXPR hmac_key( std::uint64_t seed )
+    {
+        init( hmac<H>( seed ) );
+    }
+
+    BOOST_HASH2_HMAC_CONSTEXPR hmac_key( unsigned char const* p, std::size_t n )
+    {
+        init( hmac<H>( p, n ) );
+    }
+};
+
+namespace detail
+{
+
+struct hmac_key_access
+{
+    template<class H> static BOOST_CXX14_CONSTEXPR void load( hmac_key<H> const& key, H& inner, H& outer )
+    {
+        key.st_.load( inner, outer );
+    }
+
+    template<class H> static BOOST_CXX14_CONSTEXPR void load_inner( hmac_key<H> const& key, H& inner )
+    {
+        key.st_.load_inner( inner );
+    }
+
+    // only for block hashes
+
+    template<class H> static BOOST_CXX14_CONSTEXPR unsigned char const* inner_words( hmac_key<H> const& key ) noexcept
+    {
+        return key.st_.inner_words();
+    }
+
+    template<class H> static BOOST_CXX14_CONSTEXPR unsigned char const* outer_words( hmac_key<H> const& key ) noexcept
+    {
+        return key.st_.outer_words();
+    }
+};
+
+} // namespace detail
+
 } // namespace hash2
 } // namespace boost
 
@@ -0,0 +1,168 @@
+#ifndef BOOST_HASH2_HMAC_BATCH_HPP_INCLUDED
+#define BOOST_HASH2_HMAC_BATCH_HPP_INCLUDED
+
+// Copyright 2024 Peter Dimov.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/hash2/hmac.hpp>
+#include <boost/hash2/sha2.hpp>
+#include <boost/hash2/sha2_256d.hpp>
+#include <boost/hash2/digest.hpp>
+#include <boost/hash2/update_buffers.hpp>
+#include <boost/hash2/detail/hmac_sha2_256.hpp>
+#include <boost/hash2/detail/read.hpp>
+#include <boost/hash2/detail/memcpy.hpp>
+#include <type_traits>
+#include <utility>
+#include <cstddef>
+
+namespace boost
+{
+namespace hash2
+{
+
+namespace detail
+{
+
+// the running time depends only on n, not on the contents
+
+inline bool constant_time_equal( unsigned char const* p, unsigned char const* q, std::size_t n ) noexcept
+{
+    unsigned char r = 0;
+
+    for( std::size_t i = 0; i < n; ++i )
+    {
+        r = static_cast<unsigned char>( r | ( p[ i ] ^ q[ i ] ) );
+    }
+
+    return r == 0;
+}
+
+// one message at a time
+
+template<class H, class KeyIt, class MsgIt, class F>
+void hmac_batch_( KeyIt keys, MsgIt first, MsgIt last, F f, std::false_type )
+{
+    for( ; first != last; ++first, ++keys )
+    {
+        hmac<H> h( *keys );
+
+        std::pair<void const*, std::size_t> b = detail::buffer_bytes( *first, detail::buffer_priority<3>() );
+
+        if( b.second != 0 )
+        {
+            h.update( b.first, b.second );
+        }
+
+        f( h.result() );
+    }
+}
+
+// for SHA-256, the outer hash is a single pre-padded block after the key
+// block, so the outer passes of sha2_256_lanes messages are computed in
+// lockstep by the kernel of sha2_256d.hpp; the inner passes, whose
+// lengths vary, use sha2_256
+
+template<class H, class KeyIt, class MsgIt, class F>
+void hmac_batch_( KeyIt keys, MsgIt first, MsgIt last, F f, std::true_type )
+{
+    constexpr std::size_t L = sha2_256_lanes;
+
+    sha2_256_lanes_state<L> outer = {}, s = {};
+
+    unsigned char out[ L * 32 ] = {};
+
+    while( first != last )
+    {
+        std::size_t k = 0;
+
+        for( ; k < L && first != last; ++k, ++first, ++keys )
+        {
+            sha2_256 h;
+            hmac_key_access::load_inner( *keys, h );
+
+            std::pair<void const*, std::size_t> b = detail::buffer_bytes( *first, detail::buffer_priority<3>() );
+
+            if( b.second != 0 )
+            {
+                h.update( b.first, b.second );
+            }
+
+            digest<32> r = h.result();
+
+            for( int i = 0; i < 8; ++i )
+            {
+                s.st[ i ][ k ] = detail::read32be( r.data() + i * 4 );
+            }
+
+            unsigned char const* q = hmac_key_access::outer_words( *keys );
+
+            for( int i = 0; i < 8; ++i )
+            {
+                outer.st[ i ][ k ] = detail::read32le( q + i * 4 );
+            }
+        }
+
+        // the lanes past k hold the values of the previous group
+
+        sha2_256_32_lanes( s, outer, hmac_sha2_256_32_bits );
+        sha2_256_store_lanes( s, out );
+
+        for( std::size_t i = 0; i < k; ++i )
+        {
+            digest<32> r;
+            detail::memcpy( r.data(), out + i * 32, 32 );
+
+            f( r );
+        }
+    }
+}
+
+template<class H, class KeyIt, class MsgIt, class F>
+void hmac_batch_( KeyIt keys, MsgIt first, MsgIt last, F f )
+{
+    detail::hmac_batch_<H>( keys, first, last, f, std::is_same<H, sha2_256>() );
+}
+
+} // namespace detail
+
+template<class H, class KeyIt, class MsgIt, class Out>
+Out hmac_sign_batch( KeyIt keys, MsgIt first, MsgIt last, Out out )
+{
+    using R = typename hmac<H>::result_type;
+
+    detail::hmac_batch_<H>( keys, first, last, [&]( R const& r ){
+
+        *out = r;
+        ++out;
+
+    });
+
+    return out;
+}
+
+template<class H, class KeyIt, class MsgIt, class MacIt, class Out>
+Out hmac_verify_batch( KeyIt keys, MsgIt first, MsgIt last, MacIt macs, Out out )
+{
+    using R = typename hmac<H>::result_type;
+
+    detail::hmac_batch_<H>( keys, first, last, [&]( R const& r ){
+
+        std::pair<void const*, std::size_t> b = detail::buffer_bytes( *macs, detail::buffer_priority<3>() );
+        ++macs;
+
+        bool v = b.second == r.size() && detail::constant_time_equal( static_cast<unsigned char const*>( b.first ), r.data(), r.size() );
+
+        *out = v;
+        ++out;
+
+    });
+
+    return out;
+}
+
+} // namespace hash2
+} // namespace boost
+
+#endif // #ifndef BOOST_HASH2_HMAC_BATCH_HPP_INCLUDED
@@ -0,0 +1,179 @@
+#ifndef BOOST_HASH2_PBKDF2_HPP_INCLUDED
+#define BOOST_HASH2_PBKDF2_HPP_INCLUDED
+
+// Copyright 2024 Peter Dimov.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+//
+// PBKDF2 key derivation function, https://www.rfc-editor.org/rfc/rfc8018#section-5.2
+
+#include <boost/hash2/hmac.hpp>
+#include <boost/hash2/sha2.hpp>
+#include <boost/hash2/digest.hpp>
+#include <boost/hash2/detail/hmac_sha2_256.hpp>
+#include <boost/hash2/detail/parallel_invoke.hpp>
+#include <boost/hash2/detail/read.hpp>
+#include <boost/hash2/detail/write.hpp>
+#include <boost/hash2/detail/memcpy.hpp>
+#include <boost/throw_exception.hpp>
+#include <stdexcept>
+#include <cstdint>
+#include <cstddef>
+
+namespace boost
+{
+namespace hash2
+{
+
+namespace detail
+{
+
+// T_i = U_1 ^ U_2 ^ ... ^ U_c, U_1 = PRF(P, S || INT(i)), U_j = PRF(P, U_{j-1})
+
+template<class H>
+typename hmac<H>::result_type pbkdf2_u1( hmac_key<H> const& key, unsigned char const* salt, std::size_t sn, std::uint32_t i )
+{
+    unsigned char ib[ 4 ] = {};
+    detail::write32be( ib, i );
+
+    hmac<H> h( key );
+
+    if( sn != 0 )
+    {
+        h.update( salt, sn );
+    }
+
+    h.update( ib, 4 );
+
+    return h.result();
+}
+
+template<class H>
+void pbkdf2_block( hmac_key<H> const& key, unsigned char const* salt, std::size_t sn, std::uint32_t i, std::size_t c, unsigned char* out, std::size_t n )
+{
+    using R = typename hmac<H>::result_type;
+
+    R u = detail::pbkdf2_u1( key, salt, sn, i );
+    R t = u;
+
+    // the inner and outer states after the key block are restored from
+    // the key once, and copied in each iteration
+
+    H inner0, outer0;
+    detail::hmac_key_access::load( key, inner0, outer0 );
+
+    for( std::size_t j = 1; j < c; ++j )
+    {
+        H inner( inner0 );
+
+        inner.update( u.data(), u.size() );
+        R v = inner.result();
+
+        H outer( outer0 );
+
+        outer.update( v.data(), v.size() );
+        u = outer.result();
+
+        for( std::size_t k = 0; k < t.size(); ++k )
+        {
+            t.data()[ k ] ^= u.data()[ k ];
+        }
+    }
+
+    detail::memcpy( out, t.data(), n );
+}
+
+// for SHA-256, U_j fills a single pre-padded block after the key block,
+// so each iteration is two compressions onto the key states, without
+// going through the buffering of sha2_256
+
+inline void pbkdf2_block( hmac_key<sha2_256> const& key, unsigned char const* salt, std::size_t sn, std::uint32_t i, std::size_t c, unsigned char* out, std::size_t n )
+{
+    digest<32> const u1 = detail::pbkdf2_u1( key, salt, sn, i );
+
+    sha2_256_lanes_state<1> inner = {}, outer = {};
+    detail::hmac_sha2_256_load_lanes( key, inner, outer, 0 );
+
+    sha2_256_lanes_state<1> u = {};
+
+    for( int k = 0; k < 8; ++k )
+    {
+        u.st[ k ][ 0 ] = detail::read32be( u1.data() + k * 4 );
+    }
+
+    sha2_256_lanes_state<1> t = u;
+
+    for( std::size_t j = 1; j < c; ++j )
+    {
+        detail::hmac_sha2_256_32_lanes( u, inner, outer );
+
+        for( int k = 0; k < 8; ++k )
+        {
+            t.st[ k ][ 0 ] ^= u.st[ k ][ 0 ];
+        }
+    }
+
+    unsigned char tmp[ 32 ] = {};
+    detail::sha2_256_store_lanes( t, tmp );
+
+    detail::memcpy( out, tmp, n );
+}
+
+} // namespace detail
+
+template<class H>
+void pbkdf2( unsigned char const* password, std::size_t pn, unsigned char const* salt, std::size_t sn, std::size_t iterations, unsigned char* out, std::size_t n, std::size_t threads = 1 )
+{
+    if( iterations == 0 )
+    {
+        BOOST_THROW_EXCEPTION( std::invalid_argument( "pbkdf2: iteration count must be at least 1" ) );
+    }
+
+    if( n == 0 ) return;
+
+    std::size_t const m = typename hmac<H>::result_type().size();
+    std::size_t const k = ( n - 1 ) / m + 1; // number of output blocks
+
+    if( k > 0xFFFFFFFFu )
+    {
+        BOOST_THROW_EXCEPTION( std::length_error( "pbkdf2: output length exceeds (2^32 - 1) * hLen" ) );
+    }
+
+    hmac_key<H> const key( password, pn );
+
+    if( threads == 0 )
+    {
+        threads = detail::default_thread_count();
+    }
+
+    if( threads > k )
+    {
+        threads = k;
+    }
+
+    // thread t computes the blocks t, t + threads, t + 2 * threads, ...
+
+    auto f = [&]( std::size_t t ){
+
+        for( std::size_t i = t; i < k; i += threads )
+        {
+            std::size_t r = i + 1 < k? m: n - i * m;
+            detail::pbkdf2_block( key, salt, sn, static_cast<std::uint32_t>( i + 1 ), iterations, out + i * m, r );
+        }
+
+    };
+
+    if( threads <= 1 )
+    {
+        f( 0 );
+    }
+    else
+    {
+        detail::parallel_invoke( threads, f );
+    }
+}
+
+} // namespace hash2
+} // namespace boost
+
+#endif // #ifndef BOOST_HASH2_PBKDF2_HPP_INCLUDED
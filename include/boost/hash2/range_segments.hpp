@@ -0,0 +1,108 @@
+#ifndef BOOST_HASH2_RANGE_SEGMENTS_HPP_INCLUDED
+#define BOOST_HASH2_RANGE_SEGMENTS_HPP_INCLUDED
+
+// Copyright 2024 Peter Dimov
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <deque>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <cstddef>
+
+namespace boost
+{
+
+// forward declaration
+template<class T, class Alloc> class circular_buffer;
+
+namespace hash2
+{
+
+// range_segments<R>
+//
+// specializations are for ranges whose elements are stored in contiguous
+// segments, and have a static member function
+//
+//   template<class F> static void for_each( R const& r, F&& f );
+//
+// which calls f( p, n ) for each segment [p, p+n) of r, in order
+
+template<class R> struct range_segments
+{
+};
+
+template<class R> struct range_segments<R const>: range_segments<R>
+{
+};
+
+// the two spans of the circular buffer
+
+template<class T, class Alloc> struct range_segments< boost::circular_buffer<T, Alloc> >
+{
+    template<class F> static void for_each( boost::circular_buffer<T, Alloc> const& r, F&& f )
+    {
+        auto a1 = r.array_one();
+        auto a2 = r.array_two();
+
+        if( a1.second != 0 ) f( std::addressof( *a1.first ), a1.second );
+        if( a2.second != 0 ) f( std::addressof( *a2.first ), a2.second );
+    }
+};
+
+// std::deque doesn't expose its blocks; the elements of a block are
+// adjacent in memory, so a block ends where the next element isn't
+
+template<class T, class A> struct range_segments< std::deque<T, A> >
+{
+    template<class F> static void for_each( std::deque<T, A> const& r, F&& f )
+    {
+        auto first = r.begin();
+        auto last = r.end();
+
+        if( first == last ) return;
+
+        T const* p = std::addressof( *first );
+        std::size_t n = 1;
+
+        for( ++first; first != last; ++first )
+        {
+            T const* q = std::addressof( *first );
+
+            if( q != p + n )
+            {
+                f( p, n );
+
+                p = q;
+                n = 0;
+            }
+
+            ++n;
+        }
+
+        f( p, n );
+    }
+};
+
+namespace detail
+{
+
+// range_segments<R> is specialized with a for_each function
+
+template<class R, class En = void> struct has_range_segments: std::false_type
+{
+};
+
+template<class R> struct has_range_segments<R, decltype(
+    range_segments<R>::for_each( std::declval<R const&>(), std::declval<void(*)( typename R::value_type const*, std::size_t )>() ),
+    void())>: std::true_type
+{
+};
+
+} // namespace detail
+
+} // namespace hash2
+} // namespace boost
+
+#endif // #ifndef BOOST_HASH2_RANGE_SEGMENTS_HPP_INCLUDED
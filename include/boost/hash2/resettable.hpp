@@ -0,0 +1,264 @@
+#ifndef BOOST_HASH2_RESETTABLE_HPP_INCLUDED
+#define BOOST_HASH2_RESETTABLE_HPP_INCLUDED
+
+// Copyright 2024 Peter Dimov.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+// resettable<H> keeps the seeded state of H, so that reset() can return
+// to it without repeating the seeding work; the hash algorithms themselves
+// don't carry this state. For the block hashes, only the chaining words and
+// the message length are kept, and reset() rewinds the current object in
+// place, clearing only the bytes of the block buffer that have been written
+
+#include <boost/hash2/detail/block_state.hpp>
+#include <boost/throw_exception.hpp>
+#include <boost/config.hpp>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+
+namespace boost
+{
+namespace hash2
+{
+
+template<class H> class hmac;
+
+namespace detail
+{
+
+struct reset_access
+{
+    // block hashes
+
+    template<class H> static BOOST_CXX14_CONSTEXPR auto state( H const& h ) noexcept -> decltype( ( h.state_ ) )
+    {
+        return h.state_;
+    }
+
+    template<class H> static BOOST_CXX14_CONSTEXPR std::uint64_t size( H const& h ) noexcept
+    {
+        return h.n_;
+    }
+
+    template<class H> static BOOST_CXX14_CONSTEXPR bool at_block_boundary( H const& h ) noexcept
+    {
+        return h.n_ % sizeof( h.buffer_ ) == 0;
+    }
+
+    template<class H, class Word, std::size_t W> static BOOST_CXX14_CONSTEXPR void rewind( H& h, Word const (&w)[ W ], std::uint64_t n )
+    {
+        detail::rewind_block_state( h.state_, h.buffer_, h.n_, w, n );
+    }
+
+    // hmac
+
+    template<class H> static BOOST_CXX14_CONSTEXPR H const& inner( hmac<H> const& h ) noexcept
+    {
+        return h.inner_;
+    }
+
+    template<class H> static BOOST_CXX14_CONSTEXPR H& inner( hmac<H>& h ) noexcept
+    {
+        return h.inner_;
+    }
+
+    template<class H> static BOOST_CXX14_CONSTEXPR H const& outer( hmac<H> const& h ) noexcept
+    {
+        return h.outer_;
+    }
+
+    template<class H> static BOOST_CXX14_CONSTEXPR H& outer( hmac<H>& h ) noexcept
+    {
+        return h.outer_;
+    }
+};
+
+// the state to which resettable<H> returns; a copy of H by default
+
+template<class H, bool E = has_state_export<H>::value> class reset_state
+{
+private:
+
+    H h0_;
+
+public:
+
+    BOOST_CXX14_CONSTEXPR explicit reset_state( H const& h ): h0_( h )
+    {
+    }
+
+    BOOST_CXX14_CONSTEXPR void restore( H& h ) const
+    {
+        h = h0_;
+    }
+
+    BOOST_CXX14_CONSTEXPR H get() const
+    {
+        return h0_;
+    }
+};
+
+// for block hashes, the chaining words and the message length; the
+// state must be at a block boundary, where the block buffer is empty
+
+template<class H> class reset_state<H, true>
+{
+private:
+
+    using A = typename std::remove_reference<decltype( reset_access::state( std::declval<H const&>() ) )>::type;
+
+    using word_type = typename std::remove_const<typename std::remove_extent<A>::type>::type;
+    static constexpr std::size_t W = std::extent<A>::value;
+
+    word_type w_[ W ] = {};
+    std::uint64_t n_ = 0;
+
+public:
+
+    BOOST_CXX14_CONSTEXPR explicit reset_state( H const& h )
+    {
+        if( !reset_access::at_block_boundary( h ) )
+        {
+            BOOST_THROW_EXCEPTION( std::invalid_argument( "resettable: the state of a block hash must be at a block boundary" ) );
+        }
+
+        A& w = reset_access::state( h );
+
+        for( std::size_t i = 0; i < W; ++i )
+        {
+            w_[ i ] = w[ i ];
+        }
+
+        n_ = reset_access::size( h );
+    }
+
+    BOOST_CXX14_CONSTEXPR void restore( H& h ) const
+    {
+        reset_access::rewind( h, w_, n_ );
+    }
+
+    BOOST_CXX14_CONSTEXPR H get() const
+    {
+        H h;
+        restore( h );
+
+        return h;
+    }
+};
+
+// for hmac, the states of the inner and the outer hash
+
+template<class H> class reset_state<hmac<H>, false>
+{
+private:
+
+    reset_state<H> inner_;
+    reset_state<H> outer_;
+
+public:
+
+    BOOST_CXX14_CONSTEXPR explicit reset_state( hmac<H> const& h ): inner_( reset_access::inner( h ) ), outer_( reset_access::outer( h ) )
+    {
+    }
+
+    BOOST_CXX14_CONSTEXPR void restore( hmac<H>& h ) const
+    {
+        inner_.restore( reset_access::inner( h ) );
+        outer_.restore( reset_access::outer( h ) );
+    }
+
+    BOOST_CXX14_CONSTEXPR hmac<H> get() const
+    {
+        hmac<H> h;
+        restore( h );
+
+        return h;
+    }
+};
+
+} // namespace detail
+
+template<class H> class resettable
+{
+private:
+
+    H h_;
+    detail::reset_state<H> h0_; // the state restored by reset()
+
+public:
+
+    using hash_type = H;
+    using result_type = typename H::result_type;
+
+    BOOST_CXX14_CONSTEXPR resettable(): h_(), h0_( h_ )
+    {
+    }
+
+    BOOST_CXX14_CONSTEXPR explicit resettable( std::uint64_t seed ): h_( seed ), h0_( h_ )
+    {
+    }
+
+    BOOST_CXX14_CONSTEXPR resettable( unsigned char const* p, std::size_t n ): h_( p, n ), h0_( h_ )
+    {
+    }
+
+    // h can be in any state, e.g. one obtained with import_state,
+    // but a block hash must be at a block boundary
+    BOOST_CXX14_CONSTEXPR explicit resettable( H const& h ): h_( h ), h0_( h_ )
+    {
+    }
+
+    BOOST_CXX14_CONSTEXPR void reset()
+    {
+        h0_.restore( h_ );
+    }
+
+    BOOST_CXX14_CONSTEXPR void reseed( std::uint64_t seed )
+    {
+        h_ = H( seed );
+        h0_ = detail::reset_state<H>( h_ );
+    }
+
+    BOOST_CXX14_CONSTEXPR void reseed( unsigned char const* p, std::size_t n )
+    {
+        h_ = H( p, n );
+        h0_ = detail::reset_state<H>( h_ );
+    }
+
+    BOOST_CXX14_CONSTEXPR void update( unsigned char const* p, std::size_t n )
+    {
+        h_.update( p, n );
+    }
+
+    void update( void const* pv, std::size_t n )
+    {
+        unsigned char const* p = static_cast<unsigned char const*>( pv );
+        update( p, n );
+    }
+
+    BOOST_CXX14_CONSTEXPR result_type result()
+    {
+        return h_.result();
+    }
+
+    // the state restored by reset()
+    BOOST_CXX14_CONSTEXPR H initial() const
+    {
+        return h0_.get();
+    }
+
+    // the current state
+    BOOST_CXX14_CONSTEXPR H const& get() const noexcept
+    {
+        return h_;
+    }
+};
+
+} // namespace hash2
+} // namespace boost
+
+#endif // #ifndef BOOST_HASH2_RESETTABLE_HPP_INCLUDED
@@ -0,0 +1,100 @@
+#ifndef BOOST_HASH2_RESULT_INTO_HPP_INCLUDED
+#define BOOST_HASH2_RESULT_INTO_HPP_INCLUDED
+
+// Copyright 2024 Peter Dimov.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/hash2/detail/memcpy.hpp>
+#include <boost/config.hpp>
+#include <type_traits>
+#include <utility>
+#include <cstddef>
+
+namespace boost
+{
+namespace hash2
+{
+
+namespace detail
+{
+
+// algorithms with a native extendable output provide h.result_into(p, n)
+
+template<class Hash, class En = void> struct has_result_into: std::false_type
+{
+};
+
+template<class Hash> struct has_result_into<Hash, decltype(
+    std::declval<Hash&>().result_into( std::declval<unsigned char*>(), std::declval<std::size_t>() ),
+    void())>: std::true_type
+{
+};
+
+// stores the first n bytes of r; integral results in little endian order
+
+template<class R>
+    BOOST_CXX14_CONSTEXPR
+    typename std::enable_if< std::is_integral<R>::value, void >::type
+    write_result( unsigned char* p, std::size_t n, R r )
+{
+    for( std::size_t i = 0; i < n; ++i )
+    {
+        p[ i ] = static_cast<unsigned char>( r & 0xFF );
+        r >>= 8;
+    }
+}
+
+template<class R>
+    BOOST_CXX14_CONSTEXPR
+    typename std::enable_if< !std::is_integral<R>::value, void >::type
+    write_result( unsigned char* p, std::size_t n, R const& r )
+{
+    detail::memcpy( p, r.data(), n );
+}
+
+template<class Hash>
+BOOST_CXX14_CONSTEXPR void result_into_( Hash& h, unsigned char* p, std::size_t n, std::true_type )
+{
+    h.result_into( p, n );
+}
+
+template<class Hash>
+BOOST_CXX14_CONSTEXPR void result_into_( Hash& h, unsigned char* p, std::size_t n, std::false_type )
+{
+    using R = typename Hash::result_type;
+
+    // integral types, std::array<unsigned char, N>, digest<N>
+    constexpr std::size_t M = sizeof( R );
+
+    // consecutive results form the extended output
+
+    while( n > 0 )
+    {
+        std::size_t k = n < M? n: M;
+
+        detail::write_result( p, k, h.result() );
+
+        p += k;
+        n -= k;
+    }
+}
+
+} // namespace detail
+
+template<class Hash>
+BOOST_CXX14_CONSTEXPR void result_into( Hash& h, unsigned char* p, std::size_t n )
+{
+    detail::result_into_( h, p, n, detail::has_result_into<Hash>() );
+}
+
+template<class Hash>
+void result_into( Hash& h, void* p, std::size_t n )
+{
+    hash2::result_into( h, static_cast<unsigned char*>( p ), n );
+}
+
+} // namespace hash2
+} // namespace boost
+
+#endif // #ifndef BOOST_HASH2_RESULT_INTO_HPP_INCLUDED
@@ -0,0 +1,395 @@
+#ifndef BOOST_HASH2_ROLLING_HASH_HPP_INCLUDED
+#define BOOST_HASH2_ROLLING_HASH_HPP_INCLUDED
+
+// Copyright 2024 Peter Dimov.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+// Rolling hashes over a sliding window of bytes:
+//
+// Rabin-Karp, https://en.wikipedia.org/wiki/Rabin%E2%80%93Karp_algorithm
+// Buzhash (cyclic polynomial), https://en.wikipedia.org/wiki/Rolling_hash#Cyclic_polynomial
+// Gear, as used by FastCDC, https://www.usenix.org/conference/atc16/technical-sessions/presentation/xia
+//
+// The byte tables are derived from the seed with SipHash-2-4
+
+#include <boost/hash2/siphash.hpp>
+#include <boost/hash2/detail/rot.hpp>
+#include <boost/config.hpp>
+#include <cstdint>
+#include <cstddef>
+
+namespace boost
+{
+namespace hash2
+{
+
+namespace detail
+{
+
+// fills t with the output of h, after an algorithm id
+// that makes the tables of different algorithms independent
+
+BOOST_CXX14_CONSTEXPR inline void rolling_table( siphash_64& h, unsigned char id, std::uint64_t (&t)[ 256 ] )
+{
+    h.update( &id, 1 );
+
+    for( int i = 0; i < 256; ++i )
+    {
+        t[ i ] = h.result();
+    }
+}
+
+constexpr unsigned char rolling_id_rabin_karp = 1;
+constexpr unsigned char rolling_id_buzhash = 2;
+constexpr unsigned char rolling_id_gear = 3;
+
+} // namespace detail
+
+// h = h * B + T[in] - B^W * T[out] (mod 2^64), with a random odd B
+
+template<std::size_t W> class rabin_karp_64
+{
+private:
+
+    static_assert( W > 0, "The window size must not be zero" );
+
+    std::uint64_t table_[ 256 ] = {};
+
+    std::uint64_t b_ = 0;  // the multiplier
+    std::uint64_t bw_ = 0; // b_ to the power of W
+
+    std::uint64_t h_ = 0;
+
+private:
+
+    BOOST_CXX14_CONSTEXPR void init_( siphash_64& h )
+    {
+        detail::rolling_table( h, detail::rolling_id_rabin_karp, table_ );
+
+        b_ = h.result() | 1;
+
+        std::uint64_t r = 1;
+
+        for( std::size_t i = 0; i < W; ++i )
+        {
+            r *= b_;
+        }
+
+        bw_ = r;
+    }
+
+public:
+
+    using result_type = std::uint64_t;
+
+    static constexpr std::size_t window = W;
+
+    BOOST_CXX14_CONSTEXPR rabin_karp_64()
+    {
+        siphash_64 h;
+        init_( h );
+    }
+
+    BOOST_CXX14_CONSTEXPR explicit rabin_karp_64( std::uint64_t seed )
+    {
+        siphash_64 h( seed );
+        init_( h );
+    }
+
+    BOOST_CXX14_CONSTEXPR rabin_karp_64( unsigned char const* p, std::size_t n )
+    {
+        siphash_64 h( p, n );
+        init_( h );
+    }
+
+    rabin_karp_64( void const* p, std::size_t n ): rabin_karp_64( static_cast<unsigned char const*>( p ), n )
+    {
+    }
+
+    // discards all bytes; the tables are kept
+    BOOST_CXX14_CONSTEXPR void reset() noexcept
+    {
+        h_ = 0;
+    }
+
+    // appends bytes without removing any; used to fill the window
+    BOOST_CXX14_CONSTEXPR void update( unsigned char const* p, std::size_t n ) noexcept
+    {
+        std::uint64_t h = h_;
+
+        for( std::size_t i = 0; i < n; ++i )
+        {
+            h = h * b_ + table_[ p[ i ] ];
+        }
+
+        h_ = h;
+    }
+
+    void update( void const* p, std::size_t n ) noexcept
+    {
+        update( static_cast<unsigned char const*>( p ), n );
+    }
+
+    // appends `in` and removes `out`, the byte W positions before it
+    BOOST_CXX14_CONSTEXPR void roll( unsigned char out, unsigned char in ) noexcept
+    {
+        h_ = h_ * b_ + table_[ in ] - bw_ * table_[ out ];
+    }
+
+    BOOST_CXX14_CONSTEXPR std::uint64_t value() const noexcept
+    {
+        return h_;
+    }
+
+    // calls f( i, v ) for each i in [W, n], where v is the hash of [p+i-W, p+i)
+    template<class F> BOOST_CXX14_CONSTEXPR void scan( unsigned char const* p, std::size_t n, F&& f )
+    {
+        if( n < W ) return;
+
+        reset();
+        update( p, W );
+
+        f( W, h_ );
+
+        std::uint64_t h = h_;
+
+        for( std::size_t i = W; i < n; ++i )
+        {
+            h = h * b_ + table_[ p[ i ] ] - bw_ * table_[ p[ i - W ] ];
+            f( i + 1, h );
+        }
+
+        h_ = h;
+    }
+};
+
+// h = rotl( h, 1 ) ^ T[in] ^ rotl( T[out], W )
+
+template<std::size_t W> class buzhash_64
+{
+private:
+
+    static_assert( W > 0, "The window size must not be zero" );
+
+    std::uint64_t table_[ 256 ] = {};
+    std::uint64_t out_[ 256 ] = {}; // table_ rotated left by W
+
+    std::uint64_t h_ = 0;
+
+private:
+
+    BOOST_FORCEINLINE static BOOST_CXX14_CONSTEXPR std::uint64_t rotl_( std::uint64_t v, int k ) noexcept
+    {
+        return k == 0? v: detail::rotl( v, k );
+    }
+
+    BOOST_CXX14_CONSTEXPR void init_( siphash_64& h )
+    {
+        detail::rolling_table( h, detail::rolling_id_buzhash, table_ );
+
+        for( int i = 0; i < 256; ++i )
+        {
+            out_[ i ] = rotl_( table_[ i ], static_cast<int>( W % 64 ) );
+        }
+    }
+
+public:
+
+    using result_type = std::uint64_t;
+
+    static constexpr std::size_t window = W;
+
+    BOOST_CXX14_CONSTEXPR buzhash_64()
+    {
+        siphash_64 h;
+        init_( h );
+    }
+
+    BOOST_CXX14_CONSTEXPR explicit buzhash_64( std::uint64_t seed )
+    {
+        siphash_64 h( seed );
+        init_( h );
+    }
+
+    BOOST_CXX14_CONSTEXPR buzhash_64( unsigned char const* p, std::size_t n )
+    {
+        siphash_64 h( p, n );
+        init_( h );
+    }
+
+    buzhash_64( void const* p, std::size_t n ): buzhash_64( static_cast<unsigned char const*>( p ), n )
+    {
+    }
+
+    BOOST_CXX14_CONSTEXPR void reset() noexcept
+    {
+        h_ = 0;
+    }
+
+    BOOST_CXX14_CONSTEXPR void update( unsigned char const* p, std::size_t n ) noexcept
+    {
+        std::uint64_t h = h_;
+
+        for( std::size_t i = 0; i < n; ++i )
+        {
+            h = detail::rotl( h, 1 ) ^ table_[ p[ i ] ];
+        }
+
+        h_ = h;
+    }
+
+    void update( void const* p, std::size_t n ) noexcept
+    {
+        update( static_cast<unsigned char const*>( p ), n );
+    }
+
+    BOOST_CXX14_CONSTEXPR void roll( unsigned char out, unsigned char in ) noexcept
+    {
+        h_ = detail::rotl( h_, 1 ) ^ table_[ in ] ^ out_[ out ];
+    }
+
+    BOOST_CXX14_CONSTEXPR std::uint64_t value() const noexcept
+    {
+        return h_;
+    }
+
+    template<class F> BOOST_CXX14_CONSTEXPR void scan( unsigned char const* p, std::size_t n, F&& f )
+    {
+        if( n < W ) return;
+
+        reset();
+        update( p, W );
+
+        f( W, h_ );
+
+        std::uint64_t h = h_;
+
+        for( std::size_t i = W; i < n; ++i )
+        {
+            h = detail::rotl( h, 1 ) ^ table_[ p[ i ] ] ^ out_[ p[ i - W ] ];
+            f( i + 1, h );
+        }
+
+        h_ = h;
+    }
+};
+
+// h = ( h << 1 ) + T[in]; a byte is shifted out after 64 steps,
+// so the window is 64 and roll() doesn't need the outgoing byte
+
+class gear_64
+{
+private:
+
+    std::uint64_t table_[ 256 ] = {};
+
+    std::uint64_t h_ = 0;
+
+private:
+
+    BOOST_CXX14_CONSTEXPR void init_( siphash_64& h )
+    {
+        detail::rolling_table( h, detail::rolling_id_gear, table_ );
+    }
+
+public:
+
+    using result_type = std::uint64_t;
+
+    static constexpr std::size_t window = 64;
+
+    BOOST_CXX14_CONSTEXPR gear_64()
+    {
+        siphash_64 h;
+        init_( h );
+    }
+
+    BOOST_CXX14_CONSTEXPR explicit gear_64( std::uint64_t seed )
+    {
+        siphash_64 h( seed );
+        init_( h );
+    }
+
+    BOOST_CXX14_CONSTEXPR gear_64( unsigned char const* p, std::size_t n )
+    {
+        siphash_64 h( p, n );
+        init_( h );
+    }
+
+    gear_64( void const* p, std::size_t n ): gear_64( static_cast<unsigned char const*>( p ), n )
+    {
+    }
+
+    BOOST_CXX14_CONSTEXPR void reset() noexcept
+    {
+        h_ = 0;
+    }
+
+    BOOST_CXX14_CONSTEXPR void update( unsigned char const* p, std::size_t n ) noexcept
+    {
+        std::uint64_t h = h_;
+
+        for( std::size_t i = 0; i < n; ++i )
+        {
+            h = ( h << 1 ) + table_[ p[ i ] ];
+        }
+
+        h_ = h;
+    }
+
+    void update( void const* p, std::size_t n ) noexcept
+    {
+        update( static_cast<unsigned char const*>( p ), n );
+    }
+
+    BOOST_CXX14_CONSTEXPR void roll( unsigned char /*out*/, unsigned char in ) noexcept
+    {
+        h_ = ( h_ << 1 ) + table_[ in ];
+    }
+
+    BOOST_CXX14_CONSTEXPR std::uint64_t value() const noexcept
+    {
+        return h_;
+    }
+
+    // the table entry of byte c
+    BOOST_CXX14_CONSTEXPR std::uint64_t table( unsigned char c ) const noexcept
+    {
+        return table_[ c ];
+    }
+
+    template<class F> BOOST_CXX14_CONSTEXPR void scan( unsigned char const* p, std::size_t n, F&& f )
+    {
+        std::size_t const w = window; // avoid odr-use of window in C++11
+
+        if( n < w ) return;
+
+        reset();
+        update( p, w );
+
+        f( w, h_ );
+
+        std::uint64_t h = h_;
+
+        for( std::size_t i = w; i < n; ++i )
+        {
+            h = ( h << 1 ) + table_[ p[ i ] ];
+            f( i + 1, h );
+        }
+
+        h_ = h;
+    }
+};
+
+#if defined(BOOST_NO_CXX17_INLINE_VARIABLES)
+
+template<std::size_t W> constexpr std::size_t rabin_karp_64<W>::window;
+template<std::size_t W> constexpr std::size_t buzhash_64<W>::window;
+
+#endif
+
+} // namespace hash2
+} // namespace boost
+
+#endif // #ifndef BOOST_HASH2_ROLLING_HASH_HPP_INCLUDED
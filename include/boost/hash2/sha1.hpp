@@ -11,6 +11,7 @@
 #include <boost/hash2/digest.hpp>
 #include <boost/hash2/detail/read.hpp>
 #include <boost/hash2/detail/write.hpp>
+#include <boost/hash2/detail/block_state.hpp>
 #include <boost/hash2/detail/rot.hpp>
 #include <boost/hash2/detail/memcpy.hpp>
 #include <boost/hash2/detail/memset.hpp>
@@ -30,12 +31,13 @@ class sha1_160
 {
 private:
 
+    friend struct detail::reset_access;
+
     std::uint32_t state_[ 5 ] = { 0x67452301u, 0xefcdab89u, 0x98badcfeu, 0x10325476u, 0xc3d2e1f0u };
 
     static constexpr int N = 64;
 
     unsigned char buffer_[ N ] = {};
-    std::size_t m_ = 0; // == n_ % N
 
     std::uint64_t n_ = 0;
 
@@ -195,6 +197,7 @@ public:
     typedef digest<20> result_type;
 
     static constexpr int block_size = 64;
+    static constexpr std::size_t state_size = detail::block_state_size<std::uint32_t, 5, N>::value;
 
     sha1_160() = default;
 
@@ -219,40 +222,50 @@ public:
         }
     }
 
-    BOOST_CXX14_CONSTEXPR void update( unsigned char const* p, std::size_t n )
+    BOOST_CXX14_CONSTEXPR void reseed( std::uint64_t seed )
+    {
+        *this = sha1_160( seed );
+    }
+
+    BOOST_CXX14_CONSTEXPR void reseed( unsigned char const * p, std::size_t n )
     {
-        BOOST_ASSERT( m_ == n_ % N );
+        *this = sha1_160( p, n );
+    }
 
+    BOOST_CXX14_CONSTEXPR void update( unsigned char const* p, std::size_t n )
+    {
         if( n == 0 ) return;
 
+        std::size_t m = static_cast<std::size_t>( n_ % N );
+
         n_ += n;
 
-        if( m_ > 0 )
+        if( m > 0 )
         {
-            std::size_t k = N - m_;
+            std::size_t k = N - m;
 
             if( n < k )
             {
                 k = n;
             }
 
-            detail::memcpy( buffer_ + m_, p, k );
+            detail::memcpy( buffer_ + m, p, k );
 
             p += k;
             n -= k;
-            m_ += k;
+            m += k;
 
-            if( m_ < N ) return;
+            if( m < N ) return;
 
-            BOOST_ASSERT( m_ == N );
+            BOOST_ASSERT( m == N );
 
             transform( buffer_ );
-            m_ = 0;
+            m = 0;
 
             detail::memset( buffer_, 0, N );
         }
 
-        BOOST_ASSERT( m_ == 0 );
+        BOOST_ASSERT( m == 0 );
 
         while( n >= N )
         {
@@ -267,10 +280,7 @@ public:
         if( n > 0 )
         {
             detail::memcpy( buffer_, p, n );
-            m_ = n;
         }
-
-        BOOST_ASSERT( m_ == n_ % N );
     }
 
     void update( void const* pv, std::size_t n )
@@ -279,15 +289,25 @@ public:
         update( p, n );
     }
 
+    BOOST_CXX14_CONSTEXPR void export_state( unsigned char* p ) const
+    {
+        detail::export_block_state( p, detail::block_state_sha1_160, state_, buffer_, n_ );
+    }
+
+    BOOST_CXX14_CONSTEXPR bool import_state( unsigned char const* p )
+    {
+        return detail::import_block_state( p, detail::block_state_sha1_160, state_, buffer_, n_ );
+    }
+
     BOOST_CXX14_CONSTEXPR result_type result()
     {
-        BOOST_ASSERT( m_ == n_ % N );
+        std::size_t m = static_cast<std::size_t>( n_ % N );
 
         unsigned char bits[ 8 ] = {};
 
         detail::write64be( bits, n_ * 8 );
 
-        std::size_t k = m_ < 56? 56 - m_: 120 - m_;
+        std::size_t k = m < 56? 56 - m: 120 - m;
 
         unsigned char padding[ 64 ] = { 0x80 };
 
@@ -295,7 +315,7 @@ public:
 
         update( bits, 8 );
 
-        BOOST_ASSERT( m_ == 0 );
+        BOOST_ASSERT( n_ % N == 0 );
 
         result_type digest;
 
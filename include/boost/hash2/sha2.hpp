@@ -13,6 +13,7 @@
 #include <boost/hash2/detail/read.hpp>
 #include <boost/hash2/detail/rot.hpp>
 #include <boost/hash2/detail/write.hpp>
+#include <boost/hash2/detail/block_state.hpp>
 #include <boost/hash2/detail/memcpy.hpp>
 #include <boost/hash2/detail/memset.hpp>
 #include <boost/hash2/detail/is_constant_evaluated.hpp>
@@ -37,12 +38,23 @@ struct sha2_base
     static constexpr int N = M;
 
     unsigned char buffer_[ N ] = {};
-    std::size_t m_ = 0; // == n_ % N
 
     std::uint64_t n_ = 0;
 
+    static constexpr std::size_t state_size = block_state_size<Word, 8, N>::value;
+
     constexpr sha2_base() = default;
 
+    BOOST_CXX14_CONSTEXPR void export_state_( unsigned char* p, unsigned char id ) const
+    {
+        detail::export_block_state( p, id, state_, buffer_, n_ );
+    }
+
+    BOOST_CXX14_CONSTEXPR bool import_state_( unsigned char const* p, unsigned char id )
+    {
+        return detail::import_block_state( p, id, state_, buffer_, n_ );
+    }
+
     void update( void const* pv, std::size_t n )
     {
         unsigned char const* p = static_cast<unsigned char const*>( pv );
@@ -51,37 +63,36 @@ struct sha2_base
 
     BOOST_CXX14_CONSTEXPR void update( unsigned char const* p, std::size_t n )
     {
-
-        BOOST_ASSERT( m_ == n_ % N );
+        std::size_t m = static_cast<std::size_t>( n_ % N );
 
         n_ += n;
 
-        if( m_ > 0 )
+        if( m > 0 )
         {
-            std::size_t k = N - m_;
+            std::size_t k = N - m;
 
             if( n < k )
             {
                 k = n;
             }
 
-            detail::memcpy( buffer_ + m_, p, k );
+            detail::memcpy( buffer_ + m, p, k );
 
             p += k;
             n -= k;
-            m_ += k;
+            m += k;
 
-            if( m_ < N ) return;
+            if( m < N ) return;
 
-            BOOST_ASSERT( m_ == N );
+            BOOST_ASSERT( m == N );
 
             Algo::transform( buffer_, state_ );
-            m_ = 0;
+            m = 0;
 
             detail::memset( buffer_, 0, N );
         }
 
-        BOOST_ASSERT( m_ == 0 );
+        BOOST_ASSERT( m == 0 );
 
         while( n >= N )
         {
@@ -96,10 +107,30 @@ struct sha2_base
         if( n > 0 )
         {
             detail::memcpy( buffer_, p, n );
-            m_ = n;
         }
+    }
+
+    template<std::size_t K> BOOST_CXX14_CONSTEXPR void update( unsigned char const* p )
+    {
+        if( n_ % N != 0 )
+        {
+            update( p, K );
+            return;
+        }
+
+        // block-aligned state; the block count and the tail size are constants
 
-        BOOST_ASSERT( m_ == n_ % N );
+        n_ += K;
+
+        for( std::size_t i = 0; i < K / N; ++i )
+        {
+            Algo::transform( p + i * N, state_ );
+        }
+
+        if( K % N != 0 )
+        {
+            detail::memcpy( buffer_, p + K / N * N, K % N );
+        }
     }
 };
 
@@ -336,6 +367,8 @@ class sha2_256 : detail::sha2_256_base
 {
 private:
 
+    friend struct detail::reset_access;
+
     BOOST_CXX14_CONSTEXPR void init()
     {
         state_[ 0 ] = 0x6a09e667;
@@ -384,19 +417,43 @@ public:
         }
     }
 
+
     using detail::sha2_256_base::update;
 
+    using detail::sha2_256_base::state_size;
+
+    BOOST_CXX14_CONSTEXPR void reseed( std::uint64_t seed )
+    {
+        *this = sha2_256( seed );
+    }
+
+    BOOST_CXX14_CONSTEXPR void reseed( unsigned char const * p, std::size_t n )
+    {
+        *this = sha2_256( p, n );
+    }
+
+    BOOST_CXX14_CONSTEXPR void export_state( unsigned char* p ) const
+    {
+        export_state_( p, detail::block_state_sha2_256 );
+    }
+
+    BOOST_CXX14_CONSTEXPR bool import_state( unsigned char const* p )
+    {
+        return import_state_( p, detail::block_state_sha2_256 );
+    }
+
     BOOST_CXX14_CONSTEXPR result_type result()
     {
         unsigned char bits[ 8 ] = {};
         detail::write64be( bits, n_ * 8 );
 
-        std::size_t k = m_ < 56 ? 56 - m_ : 64 + 56 - m_;
+        std::size_t m = static_cast<std::size_t>( n_ % N );
+        std::size_t k = m < 56 ? 56 - m : 64 + 56 - m;
         unsigned char padding[ 64 ] = { 0x80 };
 
         update( padding, k );
         update( bits, 8 );
-        BOOST_ASSERT( m_ == 0 );
+        BOOST_ASSERT( n_ % N == 0 );
 
         result_type digest;
         for( int i = 0; i < 8; ++i )
@@ -412,6 +469,8 @@ class sha2_224 : detail::sha2_256_base
 {
 private:
 
+    friend struct detail::reset_access;
+
     BOOST_CXX14_CONSTEXPR void init()
     {
         state_[ 0 ] = 0xc1059ed8;
@@ -460,20 +519,42 @@ public:
         }
     }
 
-
     using detail::sha2_256_base::update;
 
+    using detail::sha2_256_base::state_size;
+
+    BOOST_CXX14_CONSTEXPR void reseed( std::uint64_t seed )
+    {
+        *this = sha2_224( seed );
+    }
+
+    BOOST_CXX14_CONSTEXPR void reseed( unsigned char const * p, std::size_t n )
+    {
+        *this = sha2_224( p, n );
+    }
+
+    BOOST_CXX14_CONSTEXPR void export_state( unsigned char* p ) const
+    {
+        export_state_( p, detail::block_state_sha2_224 );
+    }
+
+    BOOST_CXX14_CONSTEXPR bool import_state( unsigned char const* p )
+    {
+        return import_state_( p, detail::block_state_sha2_224 );
+    }
+
     BOOST_CXX14_CONSTEXPR result_type result()
     {
         unsigned char bits[ 8 ] = {};
         detail::write64be( bits, n_ * 8 );
 
-        std::size_t k = m_ < 56 ? 56 - m_ : 64 + 56 - m_;
+        std::size_t m = static_cast<std::size_t>( n_ % N );
+        std::size_t k = m < 56 ? 56 - m : 64 + 56 - m;
         unsigned char padding[ 64 ] = { 0x80 };
 
         update( padding, k );
         update( bits, 8 );
-        BOOST_ASSERT( m_ == 0 );
+        BOOST_ASSERT( n_ % N == 0 );
 
         result_type digest;
         for( int i = 0; i < 7; ++i ) {
@@ -488,6 +569,8 @@ class sha2_512 : detail::sha2_512_base
 {
 private:
 
+    friend struct detail::reset_access;
+
     BOOST_CXX14_CONSTEXPR void init()
     {
         state_[ 0 ] = 0x6a09e667f3bcc908;
@@ -506,6 +589,28 @@ public:
 
     using detail::sha2_512_base::update;
 
+    using detail::sha2_512_base::state_size;
+
+    BOOST_CXX14_CONSTEXPR void reseed( std::uint64_t seed )
+    {
+        *this = sha2_512( seed );
+    }
+
+    BOOST_CXX14_CONSTEXPR void reseed( unsigned char const * p, std::size_t n )
+    {
+        *this = sha2_512( p, n );
+    }
+
+    BOOST_CXX14_CONSTEXPR void export_state( unsigned char* p ) const
+    {
+        export_state_( p, detail::block_state_sha2_512 );
+    }
+
+    BOOST_CXX14_CONSTEXPR bool import_state( unsigned char const* p )
+    {
+        return import_state_( p, detail::block_state_sha2_512 );
+    }
+
     static constexpr int block_size = 128;
 
     BOOST_CXX14_CONSTEXPR sha2_512()
@@ -543,12 +648,13 @@ public:
         unsigned char bits[ 16 ] = { 0 };
         detail::write64be( bits + 8, n_ * 8 );
 
-        std::size_t k = m_ < 112 ? 112 - m_ : 128 + 112 - m_;
+        std::size_t m = static_cast<std::size_t>( n_ % N );
+        std::size_t k = m < 112 ? 112 - m : 128 + 112 - m;
         unsigned char padding[ 128 ] = { 0x80 };
 
         update( padding, k );
         update( bits, 16 );
-        BOOST_ASSERT( m_ == 0 );
+        BOOST_ASSERT( n_ % N == 0 );
 
         result_type digest;
         for( int i = 0; i < 8; ++i )
@@ -564,6 +670,8 @@ class sha2_384 : detail::sha2_512_base
 {
 private:
 
+    friend struct detail::reset_access;
+
     BOOST_CXX14_CONSTEXPR void init()
     {
         state_[ 0 ] = 0xcbbb9d5dc1059ed8;
@@ -584,6 +692,28 @@ public:
 
     using detail::sha2_512_base::update;
 
+    using detail::sha2_512_base::state_size;
+
+    BOOST_CXX14_CONSTEXPR void reseed( std::uint64_t seed )
+    {
+        *this = sha2_384( seed );
+    }
+
+    BOOST_CXX14_CONSTEXPR void reseed( unsigned char const * p, std::size_t n )
+    {
+        *this = sha2_384( p, n );
+    }
+
+    BOOST_CXX14_CONSTEXPR void export_state( unsigned char* p ) const
+    {
+        export_state_( p, detail::block_state_sha2_384 );
+    }
+
+    BOOST_CXX14_CONSTEXPR bool import_state( unsigned char const* p )
+    {
+        return import_state_( p, detail::block_state_sha2_384 );
+    }
+
     BOOST_CXX14_CONSTEXPR sha2_384()
     {
         init();
@@ -619,12 +749,13 @@ public:
         unsigned char bits[ 16 ] = { 0 };
         detail::write64be( bits + 8, n_ * 8 );
 
-        std::size_t k = m_ < 112 ? 112 - m_ : 128 + 112 - m_;
+        std::size_t m = static_cast<std::size_t>( n_ % N );
+        std::size_t k = m < 112 ? 112 - m : 128 + 112 - m;
         unsigned char padding[ 128 ] = { 0x80 };
 
         update( padding, k );
         update( bits, 16 );
-        BOOST_ASSERT( m_ == 0 );
+        BOOST_ASSERT( n_ % N == 0 );
 
         result_type digest;
         for( int i = 0; i < 6; ++i )
@@ -640,6 +771,8 @@ class sha2_512_224 : detail::sha2_512_base
 {
 private:
 
+    friend struct detail::reset_access;
+
     BOOST_CXX14_CONSTEXPR void init()
     {
         state_[ 0 ] = 0x8c3d37c819544da2;
@@ -660,6 +793,28 @@ public:
 
     using detail::sha2_512_base::update;
 
+    using detail::sha2_512_base::state_size;
+
+    BOOST_CXX14_CONSTEXPR void reseed( std::uint64_t seed )
+    {
+        *this = sha2_512_224( seed );
+    }
+
+    BOOST_CXX14_CONSTEXPR void reseed( unsigned char const * p, std::size_t n )
+    {
+        *this = sha2_512_224( p, n );
+    }
+
+    BOOST_CXX14_CONSTEXPR void export_state( unsigned char* p ) const
+    {
+        export_state_( p, detail::block_state_sha2_512_224 );
+    }
+
+    BOOST_CXX14_CONSTEXPR bool import_state( unsigned char const* p )
+    {
+        return import_state_( p, detail::block_state_sha2_512_224 );
+    }
+
     BOOST_CXX14_CONSTEXPR sha2_512_224()
     {
         init();
@@ -696,12 +851,13 @@ public:
         unsigned char bits[ 16 ] = { 0 };
         detail::write64be( bits + 8, n_ * 8 );
 
-        std::size_t k = m_ < 112 ? 112 - m_ : 128 + 112 - m_;
+        std::size_t m = static_cast<std::size_t>( n_ % N );
+        std::size_t k = m < 112 ? 112 - m : 128 + 112 - m;
         unsigned char padding[ 128 ] = { 0x80 };
 
         update( padding, k );
         update( bits, 16 );
-        BOOST_ASSERT( m_ == 0 );
+        BOOST_ASSERT( n_ % N == 0 );
 
         result_type digest;
         for( int i = 0; i < 3; ++i )
@@ -718,6 +874,8 @@ class sha2_512_256 : detail::sha2_512_base
 {
 private:
 
+    friend struct detail::reset_access;
+
     BOOST_CXX14_CONSTEXPR void init()
     {
         state_[ 0 ] = 0x22312194fc2bf72c;
@@ -738,6 +896,28 @@ public:
 
     using detail::sha2_512_base::update;
 
+    using detail::sha2_512_base::state_size;
+
+    BOOST_CXX14_CONSTEXPR void reseed( std::uint64_t seed )
+    {
+        *this = sha2_512_256( seed );
+    }
+
+    BOOST_CXX14_CONSTEXPR void reseed( unsigned char const * p, std::size_t n )
+    {
+        *this = sha2_512_256( p, n );
+    }
+
+    BOOST_CXX14_CONSTEXPR void export_state( unsigned char* p ) const
+    {
+        export_state_( p, detail::block_state_sha2_512_256 );
+    }
+
+    BOOST_CXX14_CONSTEXPR bool import_state( unsigned char const* p )
+    {
+        return import_state_( p, detail::block_state_sha2_512_256 );
+    }
+
     BOOST_CXX14_CONSTEXPR sha2_512_256()
     {
         init();
@@ -773,12 +953,13 @@ public:
         unsigned char bits[ 16 ] = { 0 };
         detail::write64be( bits + 8, n_ * 8 );
 
-        std::size_t k = m_ < 112 ? 112 - m_ : 128 + 112 - m_;
+        std::size_t m = static_cast<std::size_t>( n_ % N );
+        std::size_t k = m < 112 ? 112 - m : 128 + 112 - m;
         unsigned char padding[ 128 ] = { 0x80 };
 
         update( padding, k );
         update( bits, 16 );
-        BOOST_ASSERT( m_ == 0 );
+        BOOST_ASSERT( n_ % N == 0 );
 
         result_type digest;
         for( int i = 0; i < 4; ++i )
@@ -0,0 +1,342 @@
+#ifndef BOOST_HASH2_SHA2_256D_HPP_INCLUDED
+#define BOOST_HASH2_SHA2_256D_HPP_INCLUDED
+
+// Copyright 2024 Peter Dimov.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+// SHA-256d, sha2_256( sha2_256( x ) ), and SHA-256 of 64 byte messages,
+// such as the concatenated child digests of a Merkle tree node.
+//
+// The padding block of a 64 byte message and the single block of a 32 byte
+// message are known in advance, so these are computed directly on the
+// message schedule, bypassing the buffering of sha2_256::update.
+
+#include <boost/hash2/sha2.hpp>
+#include <boost/hash2/digest.hpp>
+#include <boost/hash2/detail/read.hpp>
+#include <boost/hash2/detail/write.hpp>
+#include <boost/config.hpp>
+#include <cstdint>
+#include <cstddef>
+
+namespace boost
+{
+namespace hash2
+{
+
+namespace detail
+{
+
+// number of messages processed in lockstep by the batch functions
+
+constexpr std::size_t sha2_256_lanes = 4;
+
+template<class = void>
+struct sha2_256_fixed_constants
+{
+    // K[t] + W[t] for the padding block of a 64 byte message:
+    // 0x80, 55 zero bytes, and the bit length 512
+
+    constexpr static std::uint32_t const KW64[ 64 ] =
+    {
+        0xc28a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+        0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf374,
+        0x649b69c1, 0xf0fe4786, 0x0fe1edc6, 0x240cf254, 0x4fe9346f, 0x6cc984be, 0x61b9411e, 0x16f988fa,
+        0xf2c65152, 0xa88e5a6d, 0xb019fc65, 0xb9d99ec7, 0x9a1231c3, 0xe70eeaa0, 0xfdb1232b, 0xc7353eb0,
+        0x3069bad5, 0xcb976d5f, 0x5a0f118f, 0xdc1eeefd, 0x0a35b689, 0xde0b7a04, 0x58f4ca9d, 0xe15d5b16,
+        0x007f3e86, 0x37088980, 0xa507ea32, 0x6fab9537, 0x17406110, 0x0d8cd6f1, 0xcdaa3b6d, 0xc0bbbe37,
+        0x83613bda, 0xdb48a363, 0x0b02e931, 0x6fd15ca7, 0x521afaca, 0x31338431, 0x6ed41a95, 0x6d437890,
+        0xc39c91f2, 0x9eccabbd, 0xb5c9a0e6, 0x532fb63c, 0xd2c741c6, 0x07237ea3, 0xa4954b68, 0x4c191d76,
+    };
+
+    constexpr static std::uint32_t const IV[ 8 ] =
+    {
+        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19,
+    };
+};
+
+#if defined(BOOST_NO_CXX17_INLINE_VARIABLES)
+
+template<class T>
+constexpr std::uint32_t sha2_256_fixed_constants<T>::KW64[ 64 ];
+
+template<class T>
+constexpr std::uint32_t sha2_256_fixed_constants<T>::IV[ 8 ];
+
+#endif
+
+// L independent SHA-256 states, word-major so that the
+// per-lane loops below operate on adjacent elements
+
+template<std::size_t L> struct sha2_256_lanes_state
+{
+    std::uint32_t st[ 8 ][ L ];
+};
+
+template<std::size_t L> BOOST_CXX14_CONSTEXPR void sha2_256_init_lanes( sha2_256_lanes_state<L>& s )
+{
+    for( int i = 0; i < 8; ++i )
+    {
+        for( std::size_t l = 0; l < L; ++l )
+        {
+            s.st[ i ][ l ] = sha2_256_fixed_constants<>::IV[ i ];
+        }
+    }
+}
+
+template<std::size_t L> BOOST_CXX14_CONSTEXPR void sha2_256_expand_lanes( std::uint32_t (&W)[ 64 ][ L ] )
+{
+    using B = sha2_256_base;
+
+    for( int t = 16; t < 64; ++t )
+    {
+        for( std::size_t l = 0; l < L; ++l )
+        {
+            W[ t ][ l ] = B::sigma1( W[ t - 2 ][ l ] ) + W[ t - 7 ][ l ] + B::sigma0( W[ t - 15 ][ l ] ) + W[ t - 16 ][ l ];
+        }
+    }
+}
+
+// K[t] + W[t] from a per-lane message schedule
+
+template<std::size_t L> struct sha2_256_kw_lanes
+{
+    std::uint32_t const (&W)[ 64 ][ L ];
+
+    BOOST_CXX14_CONSTEXPR std::uint32_t operator()( int t, std::size_t l ) const
+    {
+        return sha2_256_constants<>::K[ t ] + W[ t ][ l ];
+    }
+};
+
+// K[t] + W[t] for the padding block of a 64 byte message, the same for all lanes
+
+struct sha2_256_kw_pad64
+{
+    BOOST_CXX14_CONSTEXPR std::uint32_t operator()( int t, std::size_t /*l*/ ) const
+    {
+        return sha2_256_fixed_constants<>::KW64[ t ];
+    }
+};
+
+// one round; instead of shifting the working variables, the caller
+// rotates the roles of v[0..7], so that only d and h are written
+
+template<std::size_t L, class KW> BOOST_FORCEINLINE BOOST_CXX14_CONSTEXPR void sha2_256_round_lanes( std::uint32_t (&v)[ 8 ][ L ], int a, int b, int c, int d, int e, int f, int g, int h, int t, KW const& kw )
+{
+    using B = sha2_256_base;
+
+    for( std::size_t l = 0; l < L; ++l )
+    {
+        std::uint32_t T1 = v[ h ][ l ] + B::Sigma1( v[ e ][ l ] ) + B::Ch( v[ e ][ l ], v[ f ][ l ], v[ g ][ l ] ) + kw( t, l );
+        std::uint32_t T2 = B::Sigma0( v[ a ][ l ] ) + B::Maj( v[ a ][ l ], v[ b ][ l ], v[ c ][ l ] );
+
+        v[ d ][ l ] += T1;
+        v[ h ][ l ] = T1 + T2;
+    }
+}
+
+template<std::size_t L, class KW> BOOST_CXX14_CONSTEXPR void sha2_256_rounds_lanes( sha2_256_lanes_state<L>& s, KW const& kw )
+{
+    std::uint32_t v[ 8 ][ L ] = {};
+
+    for( int i = 0; i < 8; ++i )
+    {
+        for( std::size_t l = 0; l < L; ++l )
+        {
+            v[ i ][ l ] = s.st[ i ][ l ];
+        }
+    }
+
+    for( int t = 0; t < 64; t += 8 )
+    {
+        sha2_256_round_lanes( v, 0, 1, 2, 3, 4, 5, 6, 7, t + 0, kw );
+        sha2_256_round_lanes( v, 7, 0, 1, 2, 3, 4, 5, 6, t + 1, kw );
+        sha2_256_round_lanes( v, 6, 7, 0, 1, 2, 3, 4, 5, t + 2, kw );
+        sha2_256_round_lanes( v, 5, 6, 7, 0, 1, 2, 3, 4, t + 3, kw );
+        sha2_256_round_lanes( v, 4, 5, 6, 7, 0, 1, 2, 3, t + 4, kw );
+        sha2_256_round_lanes( v, 3, 4, 5, 6, 7, 0, 1, 2, t + 5, kw );
+        sha2_256_round_lanes( v, 2, 3, 4, 5, 6, 7, 0, 1, t + 6, kw );
+        sha2_256_round_lanes( v, 1, 2, 3, 4, 5, 6, 7, 0, t + 7, kw );
+    }
+
+    for( int i = 0; i < 8; ++i )
+    {
+        for( std::size_t l = 0; l < L; ++l )
+        {
+            s.st[ i ][ l ] += v[ i ][ l ];
+        }
+    }
+}
+
+// SHA-256 of the L 64 byte messages at p, p + 64, ..., p + 64 * (L-1)
+
+template<std::size_t L> BOOST_CXX14_CONSTEXPR void sha2_256_64_lanes( unsigned char const* p, sha2_256_lanes_state<L>& s )
+{
+    std::uint32_t W[ 64 ][ L ] = {};
+
+    for( int t = 0; t < 16; ++t )
+    {
+        for( std::size_t l = 0; l < L; ++l )
+        {
+            W[ t ][ l ] = detail::read32be( p + l * 64 + t * 4 );
+        }
+    }
+
+    sha2_256_expand_lanes( W );
+
+    sha2_256_init_lanes( s );
+
+    sha2_256_rounds_lanes( s, sha2_256_kw_lanes<L>{ W } );
+    sha2_256_rounds_lanes( s, sha2_256_kw_pad64() );
+}
+
+// replaces each lane's state with the compression, onto the same lane of h0,
+// of its 32 byte big-endian encoding followed by the padding of an n bit
+// message: 0x80, 23 zero bytes, and n. With h0 the state after the key block
+// and n = 768, this is the inner or outer hash of a 32 byte HMAC message
+
+template<std::size_t L> BOOST_CXX14_CONSTEXPR void sha2_256_32_lanes( sha2_256_lanes_state<L>& s, sha2_256_lanes_state<L> const& h0, std::uint32_t n )
+{
+    std::uint32_t W[ 64 ][ L ] = {};
+
+    for( std::size_t l = 0; l < L; ++l )
+    {
+        for( int t = 0; t < 8; ++t )
+        {
+            W[ t ][ l ] = s.st[ t ][ l ];
+        }
+
+        W[ 8 ][ l ] = 0x80000000u;
+        W[ 15 ][ l ] = n;
+    }
+
+    sha2_256_expand_lanes( W );
+
+    s = h0;
+
+    sha2_256_rounds_lanes( s, sha2_256_kw_lanes<L>{ W } );
+}
+
+// replaces each lane's state with the SHA-256 of its 32 byte big-endian encoding
+
+template<std::size_t L> BOOST_CXX14_CONSTEXPR void sha2_256_32_lanes( sha2_256_lanes_state<L>& s )
+{
+    sha2_256_lanes_state<L> h0 = {};
+    sha2_256_init_lanes( h0 );
+
+    sha2_256_32_lanes( s, h0, 256 );
+}
+
+template<std::size_t L> BOOST_CXX14_CONSTEXPR void sha2_256_store_lanes( sha2_256_lanes_state<L> const& s, unsigned char* out )
+{
+    for( std::size_t l = 0; l < L; ++l )
+    {
+        for( int i = 0; i < 8; ++i )
+        {
+            detail::write32be( out + l * 32 + i * 4, s.st[ i ][ l ] );
+        }
+    }
+}
+
+template<bool Double, std::size_t L> BOOST_CXX14_CONSTEXPR void sha2_256_64_block( unsigned char const* p, unsigned char* out )
+{
+    sha2_256_lanes_state<L> s = {};
+
+    sha2_256_64_lanes( p, s );
+
+    if( Double )
+    {
+        sha2_256_32_lanes( s );
+    }
+
+    sha2_256_store_lanes( s, out );
+}
+
+template<bool Double> BOOST_CXX14_CONSTEXPR void sha2_256_64_batch_( unsigned char const* p, std::size_t n, unsigned char* out )
+{
+    constexpr std::size_t L = sha2_256_lanes;
+
+    std::size_t i = 0;
+
+    for( ; i + L <= n; i += L )
+    {
+        sha2_256_64_block<Double, L>( p + i * 64, out + i * 32 );
+    }
+
+    for( ; i < n; ++i )
+    {
+        sha2_256_64_block<Double, 1>( p + i * 64, out + i * 32 );
+    }
+}
+
+} // namespace detail
+
+// SHA-256 of a 64 byte message
+
+inline BOOST_CXX14_CONSTEXPR digest<32> sha2_256_64( unsigned char const* p )
+{
+    digest<32> r = {};
+    detail::sha2_256_64_block<false, 1>( p, r.data() );
+
+    return r;
+}
+
+// SHA-256d (SHA-256 applied twice) of a 64 byte message
+
+inline BOOST_CXX14_CONSTEXPR digest<32> sha2_256d_64( unsigned char const* p )
+{
+    digest<32> r = {};
+    detail::sha2_256_64_block<true, 1>( p, r.data() );
+
+    return r;
+}
+
+// SHA-256d of an arbitrary message
+
+inline BOOST_CXX14_CONSTEXPR digest<32> sha2_256d( unsigned char const* p, std::size_t n )
+{
+    sha2_256 h;
+    h.update( p, n );
+
+    digest<32> r1 = h.result();
+
+    detail::sha2_256_lanes_state<1> s = {};
+
+    for( int i = 0; i < 8; ++i )
+    {
+        s.st[ i ][ 0 ] = detail::read32be( r1.data() + i * 4 );
+    }
+
+    detail::sha2_256_32_lanes( s );
+
+    digest<32> r2 = {};
+    detail::sha2_256_store_lanes( s, r2.data() );
+
+    return r2;
+}
+
+inline digest<32> sha2_256d( void const* p, std::size_t n )
+{
+    return sha2_256d( static_cast<unsigned char const*>( p ), n );
+}
+
+// SHA-256 of n consecutive 64 byte messages at p, with the n
+// 32 byte digests stored consecutively at out; e.g. one level
+// of a Merkle tree whose nodes hash their two child digests
+
+inline BOOST_CXX14_CONSTEXPR void sha2_256_64_batch( unsigned char const* p, std::size_t n, unsigned char* out )
+{
+    detail::sha2_256_64_batch_<false>( p, n, out );
+}
+
+inline BOOST_CXX14_CONSTEXPR void sha2_256d_64_batch( unsigned char const* p, std::size_t n, unsigned char* out )
+{
+    detail::sha2_256_64_batch_<true>( p, n, out );
+}
+
+} // namespace hash2
+} // namespace boost
+
+#endif // #ifndef BOOST_HASH2_SHA2_256D_HPP_INCLUDED
@@ -32,12 +32,23 @@ private:
     std::uint64_t v3 = 0x7465646279746573ULL;
 
     unsigned char buffer_[ 8 ] = {};
-    std::size_t m_ = 0; // == n_ % 8
 
     std::uint64_t n_ = 0;
 
 private:
 
+    BOOST_CXX14_CONSTEXPR void init()
+    {
+        v0 = 0x736f6d6570736575ULL;
+        v1 = 0x646f72616e646f6dULL;
+        v2 = 0x6c7967656e657261ULL;
+        v3 = 0x7465646279746573ULL;
+
+        n_ = 0;
+
+        detail::memset( buffer_, 0, 8 );
+    }
+
     BOOST_CXX14_CONSTEXPR void sipround()
     {
         v0 += v1;
@@ -68,19 +79,13 @@ private:
         v0 ^= m;
     }
 
-public:
-
-    using result_type = std::uint64_t;
-
-    siphash_64() = default;
-
-    BOOST_CXX14_CONSTEXPR explicit siphash_64( std::uint64_t seed )
+    BOOST_CXX14_CONSTEXPR void seed_( std::uint64_t seed )
     {
         v0 ^= seed;
         v2 ^= seed;
     }
 
-    BOOST_CXX14_CONSTEXPR siphash_64( unsigned char const * p, std::size_t n )
+    BOOST_CXX14_CONSTEXPR void seed_( unsigned char const * p, std::size_t n )
     {
         if( n == 16 )
         {
@@ -99,41 +104,69 @@ public:
         }
     }
 
-    BOOST_CXX14_CONSTEXPR void update( unsigned char const* p, std::size_t n )
+public:
+
+    using result_type = std::uint64_t;
+
+    siphash_64() = default;
+
+    BOOST_CXX14_CONSTEXPR explicit siphash_64( std::uint64_t seed )
+    {
+        seed_( seed );
+    }
+
+    BOOST_CXX14_CONSTEXPR siphash_64( unsigned char const * p, std::size_t n )
     {
-        BOOST_ASSERT( m_ == n_ % 8 );
+        seed_( p, n );
+    }
 
+    BOOST_CXX14_CONSTEXPR void reseed( std::uint64_t seed )
+    {
+        init();
+        seed_( seed );
+    }
+
+    BOOST_CXX14_CONSTEXPR void reseed( unsigned char const * p, std::size_t n )
+    {
+        init();
+        seed_( p, n );
+    }
+
+    BOOST_CXX14_CONSTEXPR void update( unsigned char const* p, std::size_t n )
+    {
         if( n == 0 ) return;
 
+        std::size_t m = static_cast<std::size_t>( n_ % 8 );
+
         n_ += n;
 
-        if( m_ > 0 )
+        if( m > 0 )
         {
-            std::size_t k = 8 - m_;
+            std::size_t k = 8 - m;
 
             if( n < k )
             {
                 k = n;
             }
 
-            detail::memcpy( buffer_ + m_, p, k );
+            detail::memcpy( buffer_ + m, p, k );
 
             p += k;
             n -= k;
-            m_ += k;
+            m += k;
 
-            if( m_ < 8 ) return;
+            if( m < 8 ) return;
 
-            BOOST_ASSERT( m_ == 8 );
+            BOOST_ASSERT( m == 8 );
 
             update_( buffer_ );
-            m_ = 0;
+            m = 0;
 
             // clear buffered plaintext
             detail::memset( buffer_, 0, 8 );
         }
 
-        BOOST_ASSERT( m_ == 0 );
+        BOOST_ASSERT( m == 0 );
 
         while( n >= 8 )
         {
@@ -148,10 +181,7 @@ public:
         if( n > 0 )
         {
             detail::memcpy( buffer_, p, n );
-            m_ = n;
         }
-
-        BOOST_ASSERT( m_ == n_ % 8 );
     }
 
     void update( void const* pv, std::size_t n )
@@ -160,11 +190,34 @@ public:
         update( p, n );
     }
 
+    template<std::size_t K> BOOST_CXX14_CONSTEXPR void update( unsigned char const* p )
+    {
+        if( n_ % 8 != 0 )
+        {
+            update( p, K );
+            return;
+        }
+
+        // block-aligned state; the block count and the tail size are constants
+
+        n_ += K;
+
+        for( std::size_t i = 0; i < K / 8; ++i )
+        {
+            update_( p + i * 8 );
+        }
+
+        if( K % 8 != 0 )
+        {
+            detail::memcpy( buffer_, p + K / 8 * 8, K % 8 );
+        }
+    }
+
     BOOST_CXX14_CONSTEXPR std::uint64_t result()
     {
-        BOOST_ASSERT( m_ == n_ % 8 );
+        std::size_t m = static_cast<std::size_t>( n_ % 8 );
 
-        detail::memset( buffer_ + m_, 0, 8 - m_ );
+        detail::memset( buffer_ + m, 0, 8 - m );
 
         buffer_[ 7 ] = static_cast<unsigned char>( n_ & 0xFF );
 
@@ -177,8 +230,7 @@ public:
         sipround();
         sipround();
 
-        n_ += 8 - m_;
-        m_ = 0;
+        n_ += 8 - m;
 
         // clear buffered plaintext
         detail::memset( buffer_, 0, 8 );
@@ -197,12 +249,23 @@ private:
     std::uint32_t v3 = 0x74656462;
 
     unsigned char buffer_[ 4 ] = {};
-    std::uint32_t m_ = 0; // == n_ % 4
 
     std::uint32_t n_ = 0;
 
 private:
 
+    BOOST_CXX14_CONSTEXPR void init()
+    {
+        v0 = 0;
+        v1 = 0;
+        v2 = 0x6c796765;
+        v3 = 0x74656462;
+
+        n_ = 0;
+
+        detail::memset( buffer_, 0, 4 );
+    }
+
     BOOST_CXX14_CONSTEXPR void sipround()
     {
         v0 += v1;
@@ -233,13 +296,7 @@ private:
         v0 ^= m;
     }
 
-public:
-
-    using result_type = std::uint32_t;
-
-    siphash_32() = default;
-
-    BOOST_CXX14_CONSTEXPR explicit siphash_32( std::uint64_t seed )
+    BOOST_CXX14_CONSTEXPR void seed_( std::uint64_t seed )
     {
         std::uint32_t k0 = static_cast<std::uint32_t>( seed );
         std::uint32_t k1 = static_cast<std::uint32_t>( seed >> 32 );
@@ -250,7 +307,7 @@ public:
         v3 ^= k1;
     }
 
-    BOOST_CXX14_CONSTEXPR siphash_32( unsigned char const * p, std::size_t n )
+    BOOST_CXX14_CONSTEXPR void seed_( unsigned char const * p, std::size_t n )
     {
         if( n == 8 )
         {
@@ -269,41 +326,69 @@ public:
         }
     }
 
-    BOOST_CXX14_CONSTEXPR void update( unsigned char const* p, std::size_t n )
+public:
+
+    using result_type = std::uint32_t;
+
+    siphash_32() = default;
+
+    BOOST_CXX14_CONSTEXPR explicit siphash_32( std::uint64_t seed )
+    {
+        seed_( seed );
+    }
+
+    BOOST_CXX14_CONSTEXPR siphash_32( unsigned char const * p, std::size_t n )
     {
-        BOOST_ASSERT( m_ == n_ % 4 );
+        seed_( p, n );
+    }
 
+    BOOST_CXX14_CONSTEXPR void reseed( std::uint64_t seed )
+    {
+        init();
+        seed_( seed );
+    }
+
+    BOOST_CXX14_CONSTEXPR void reseed( unsigned char const * p, std::size_t n )
+    {
+        init();
+        seed_( p, n );
+    }
+
+    BOOST_CXX14_CONSTEXPR void update( unsigned char const* p, std::size_t n )
+    {
         if( n == 0 ) return;
 
+        std::uint32_t m = n_ % 4;
+
         n_ += static_cast<std::uint32_t>( n );
 
-        if( m_ > 0 )
+        if( m > 0 )
         {
-            std::uint32_t k = 4 - m_;
+            std::uint32_t k = 4 - m;
 
             if( n < k )
             {
                 k = static_cast<std::uint32_t>( n );
             }
 
-            detail::memcpy( buffer_ + m_, p, k );
+            detail::memcpy( buffer_ + m, p, k );
 
             p += k;
             n -= k;
-            m_ += k;
+            m += k;
 
-            if( m_ < 4 ) return;
+            if( m < 4 ) return;
 
-            BOOST_ASSERT( m_ == 4 );
+            BOOST_ASSERT( m == 4 );
 
             update_( buffer_ );
-            m_ = 0;
+            m = 0;
 
             // clear buffered plaintext
             detail::memset( buffer_, 0, 4 );
         }
 
-        BOOST_ASSERT( m_ == 0 );
+        BOOST_ASSERT( m == 0 );
 
         while( n >= 4 )
         {
@@ -318,10 +403,7 @@ public:
         if( n > 0 )
         {
             detail::memcpy( buffer_, p, n );
-            m_ = static_cast<std::uint32_t>( n );
         }
-
-        BOOST_ASSERT( m_ == n_ % 4 );
     }
 
     void update( void const* pv, std::size_t n )
@@ -330,11 +412,34 @@ public:
         update( p, n );
     }
 
+    template<std::size_t K> BOOST_CXX14_CONSTEXPR void update( unsigned char const* p )
+    {
+        if( n_ % 4 != 0 )
+        {
+            update( p, K );
+            return;
+        }
+
+        // block-aligned state; the block count and the tail size are constants
+
+        n_ += static_cast<std::uint32_t>( K );
+
+        for( std::size_t i = 0; i < K / 4; ++i )
+        {
+            update_( p + i * 4 );
+        }
+
+        if( K % 4 != 0 )
+        {
+            detail::memcpy( buffer_, p + K / 4 * 4, K % 4 );
+        }
+    }
+
     BOOST_CXX14_CONSTEXPR std::uint32_t result()
     {
-        BOOST_ASSERT( m_ == n_ % 4 );
+        std::uint32_t m = n_ % 4;
 
-        detail::memset( buffer_ + m_, 0, 4 - m_ );
+        detail::memset( buffer_ + m, 0, 4 - m );
 
         buffer_[ 3 ] = static_cast<unsigned char>( n_ & 0xFF );
 
@@ -347,8 +452,7 @@ public:
         sipround();
         sipround();
 
-        n_ += 4 - m_;
-        m_ = 0;
+        n_ += 4 - m;
 
         // clear buffered plaintext
         detail::memset( buffer_, 0, 4 );
@@ -0,0 +1,639 @@
+#ifndef BOOST_HASH2_TREE_HASH_HPP_INCLUDED
+#define BOOST_HASH2_TREE_HASH_HPP_INCLUDED
+
+// Copyright 2024 Peter Dimov.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+// Binary Merkle tree hash over fixed-size leaves, with
+// domain separation between leaves (0x00) and nodes (0x01)
+
+#include <boost/hash2/result_into.hpp>
+#include <boost/hash2/detail/parallel_invoke.hpp>
+#include <boost/hash2/detail/read.hpp>
+#include <boost/hash2/detail/write.hpp>
+#include <boost/hash2/detail/memcpy.hpp>
+#include <boost/assert.hpp>
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+#include <cstdio>
+#include <cstdint>
+#include <cstddef>
+
+namespace boost
+{
+namespace hash2
+{
+
+namespace detail
+{
+
+// the inverse of write_result for a complete result
+
+template<class R>
+    typename std::enable_if< std::is_integral<R>::value, R >::type
+    read_result( unsigned char const* p )
+{
+    R r = 0;
+
+    for( std::size_t i = sizeof( R ); i > 0; --i )
+    {
+        r = static_cast<R>( ( r << 8 ) | p[ i - 1 ] );
+    }
+
+    return r;
+}
+
+template<class R>
+    typename std::enable_if< !std::is_integral<R>::value, R >::type
+    read_result( unsigned char const* p )
+{
+    R r = {};
+    detail::memcpy( r.data(), p, sizeof( R ) );
+
+    return r;
+}
+
+} // namespace detail
+
+template<class H, std::size_t LeafSize = 1024> class tree_hash
+{
+public:
+
+    using hash_type = H;
+    using result_type = typename H::result_type;
+
+    static constexpr std::size_t leaf_size = LeafSize;
+
+    // one step of an inclusion proof; `left` is true when
+    // the sibling is on the left of the path to the root
+
+    struct proof_node
+    {
+        result_type digest;
+        bool left;
+    };
+
+    // a modified part of the message, [offset, offset+size)
+
+    struct range
+    {
+        std::size_t offset;
+        std::size_t size;
+    };
+
+private:
+
+    static_assert( LeafSize > 0, "LeafSize must not be zero" );
+
+    static constexpr unsigned char leaf_prefix = 0x00;
+    static constexpr unsigned char node_prefix = 0x01;
+
+    static constexpr unsigned char file_version = 1;
+    static constexpr std::size_t file_header_size = 32;
+
+    // the threads are created on each call, so each of them is given
+    // at least this many bytes of leaves; smaller inputs are hashed
+    // on the calling thread
+    static constexpr std::size_t min_bytes_per_thread = 256 * 1024;
+    static constexpr std::size_t min_leaves_per_thread = LeafSize < min_bytes_per_thread? min_bytes_per_thread / LeafSize: 1;
+
+    // upper levels with fewer dirty nodes than this per thread
+    // are rehashed on the calling thread
+    static constexpr std::size_t min_nodes_per_thread = 256;
+
+    H h0_; // the seeded hash, copied for every leaf and node
+
+    std::uint64_t n_ = 0;
+
+    // the bytes of the last, incomplete, leaf; kept so that it can be
+    // saved, and appended to after load()
+
+    std::vector<unsigned char> tail_;
+
+    // the digests of the complete leaves; after build_(), followed by
+    // the last leaf, if incomplete, and then by the upper levels, root last
+
+    std::vector<result_type> nodes_;
+    std::size_t leaves_ = 0; // number of complete leaves
+    bool built_ = false;
+
+private:
+
+    H start_leaf_() const
+    {
+        H h( h0_ );
+        h.update( &leaf_prefix, 1 );
+
+        return h;
+    }
+
+    static void update_result_( H& h, result_type const& r )
+    {
+        unsigned char tmp[ sizeof( result_type ) ] = {};
+        detail::write_result( tmp, sizeof( result_type ), r );
+
+        h.update( tmp, sizeof( result_type ) );
+    }
+
+    // calls f(i) for i in [0, k); thread t takes [k * t / threads, k * (t+1) / threads)
+
+    template<class F> static void parallel_for_( std::size_t k, std::size_t threads, F const& f )
+    {
+        if( threads > k )
+        {
+            threads = k;
+        }
+
+        auto g = [&]( std::size_t t ){
+
+            std::size_t first = k * t / threads;
+            std::size_t last = k * ( t + 1 ) / threads;
+
+            for( std::size_t i = first; i < last; ++i )
+            {
+                f( i );
+            }
+
+        };
+
+        if( threads <= 1 )
+        {
+            for( std::size_t i = 0; i < k; ++i )
+            {
+                f( i );
+            }
+        }
+        else
+        {
+            detail::parallel_invoke( threads, g );
+        }
+    }
+
+    // hashes the k complete leaves at p into nodes_
+
+    void hash_leaves_( unsigned char const* p, std::size_t k, std::size_t threads )
+    {
+        std::size_t const i0 = nodes_.size();
+        nodes_.resize( i0 + k );
+
+        parallel_for_( k, detail::thread_count_for( k, min_leaves_per_thread, threads ), [&]( std::size_t i ){
+
+            nodes_[ i0 + i ] = hash_leaf( p + i * LeafSize, LeafSize );
+
+        });
+    }
+
+    // the number of nodes in a tree with w leaves
+
+    static std::uint64_t node_count_( std::uint64_t w )
+    {
+        std::uint64_t r = w;
+
+        for( ; w > 1; w = ( w + 1 ) / 2 )
+        {
+            r += ( w + 1 ) / 2;
+        }
+
+        return r;
+    }
+
+    void build_()
+    {
+        if( built_ ) return;
+
+        std::size_t w = leaf_count();
+
+        nodes_.reserve( 2 * w );
+
+        if( w > leaves_ )
+        {
+            nodes_.push_back( hash_leaf( tail_.data(), tail_.size() ) );
+        }
+
+        // an odd node at the end of a level is carried up unchanged
+
+        for( std::size_t b = 0; w > 1; )
+        {
+            for( std::size_t i = 0; i < w; i += 2 )
+            {
+                if( i + 1 < w )
+                {
+                    nodes_.push_back( hash_node( nodes_[ b + i ], nodes_[ b + i + 1 ] ) );
+                }
+                else
+                {
+                    result_type r = nodes_[ b + i ];
+                    nodes_.push_back( r );
+                }
+            }
+
+            b += w;
+            w = ( w + 1 ) / 2;
+        }
+
+        built_ = true;
+    }
+
+    void unbuild_()
+    {
+        if( built_ )
+        {
+            nodes_.resize( leaves_ );
+            built_ = false;
+        }
+    }
+
+public:
+
+    tree_hash() = default;
+
+    explicit tree_hash( std::uint64_t seed ): h0_( seed )
+    {
+    }
+
+    tree_hash( unsigned char const* p, std::size_t n ): h0_( p, n )
+    {
+    }
+
+    // appends [p, p+n) to the message; complete leaves are hashed
+    // as they become available, on up to `threads` threads
+
+    void update( unsigned char const* p, std::size_t n, std::size_t threads = 1 )
+    {
+        if( n == 0 ) return;
+
+        unbuild_();
+
+        std::size_t m = tail_.size();
+
+        BOOST_ASSERT( m == n_ % LeafSize );
+
+        n_ += n;
+
+        if( m > 0 )
+        {
+            std::size_t k = LeafSize - m;
+
+            if( n < k )
+            {
+                tail_.insert( tail_.end(), p, p + n );
+                return;
+            }
+
+            tail_.insert( tail_.end(), p, p + k );
+
+            p += k;
+            n -= k;
+
+            nodes_.push_back( hash_leaf( tail_.data(), LeafSize ) );
+            ++leaves_;
+
+            tail_.clear();
+        }
+
+        {
+            std::size_t k = n / LeafSize;
+
+            if( k > 0 )
+            {
+                hash_leaves_( p, k, threads );
+                leaves_ += k;
+
+                p += k * LeafSize;
+                n -= k * LeafSize;
+            }
+        }
+
+        if( n > 0 )
+        {
+            tail_.assign( p, p + n );
+        }
+    }
+
+    void update( void const* pv, std::size_t n, std::size_t threads = 1 )
+    {
+        unsigned char const* p = static_cast<unsigned char const*>( pv );
+        update( p, n, threads );
+    }
+
+    // the message length
+    std::uint64_t size() const noexcept
+    {
+        return n_;
+    }
+
+    // the number of leaves; an empty message has a single empty leaf
+    std::size_t leaf_count() const noexcept
+    {
+        return leaves_ + ( n_ % LeafSize != 0 || n_ == 0? 1: 0 );
+    }
+
+    result_type hash_leaf( unsigned char const* p, std::size_t n ) const
+    {
+        BOOST_ASSERT( n <= LeafSize );
+
+        H h = start_leaf_();
+
+        if( n != 0 )
+        {
+            h.update( p, n );
+        }
+
+        return h.result();
+    }
+
+    result_type hash_node( result_type const& left, result_type const& right ) const
+    {
+        H h( h0_ );
+        h.update( &node_prefix, 1 );
+
+        update_result_( h, left );
+        update_result_( h, right );
+
+        return h.result();
+    }
+
+    result_type root()
+    {
+        build_();
+        return nodes_.back();
+    }
+
+    std::vector<proof_node> proof( std::size_t i )
+    {
+        BOOST_ASSERT( i < leaf_count() );
+
+        build_();
+
+        std::vector<proof_node> r;
+
+        for( std::size_t b = 0, w = leaf_count(); w > 1; b += w, w = ( w + 1 ) / 2, i /= 2 )
+        {
+            std::size_t j = i ^ 1;
+
+            if( j < w )
+            {
+                r.push_back( { nodes_[ b + j ], j < i } );
+            }
+        }
+
+        return r;
+    }
+
+    // checks that the leaf [p, p+n) and the proof lead to `root`
+
+    bool verify( unsigned char const* p, std::size_t n, std::vector<proof_node> const& proof, result_type const& root ) const
+    {
+        result_type r = hash_leaf( p, n );
+
+        for( std::size_t i = 0; i < proof.size(); ++i )
+        {
+            r = proof[ i ].left? hash_node( proof[ i ].digest, r ): hash_node( r, proof[ i ].digest );
+        }
+
+        return r == root;
+    }
+
+    // [p, p+n) is the whole message, of which the parts in `dirty` have
+    // changed in place; rehashes the leaves that overlap them, and, once
+    // the tree is built, their ancestors
+
+    void rehash( unsigned char const* p, std::size_t n, std::vector<range> const& dirty, std::size_t threads = 1 )
+    {
+        BOOST_ASSERT( n == n_ );
+
+        std::vector<std::size_t> ix;
+
+        for( std::size_t i = 0; i < dirty.size(); ++i )
+        {
+            range const& r = dirty[ i ];
+
+            BOOST_ASSERT( r.offset <= n && r.size <= n - r.offset );
+
+            if( r.size == 0 ) continue;
+
+            std::size_t first = r.offset / LeafSize;
+            std::size_t last = ( r.offset + r.size - 1 ) / LeafSize;
+
+            for( std::size_t j = first; j <= last; ++j )
+            {
+                ix.push_back( j );
+            }
+        }
+
+        if( ix.empty() ) return;
+
+        std::sort( ix.begin(), ix.end() );
+        ix.erase( std::unique( ix.begin(), ix.end() ), ix.end() );
+
+        if( threads == 0 )
+        {
+            threads = detail::default_thread_count();
+        }
+
+        std::size_t k = ix.size();
+
+        if( ix.back() == leaves_ )
+        {
+            // the last leaf is incomplete
+
+            tail_.assign( p + leaves_ * LeafSize, p + n );
+
+            if( built_ )
+            {
+                nodes_[ leaves_ ] = hash_leaf( tail_.data(), tail_.size() );
+            }
+
+            --k;
+        }
+
+        parallel_for_( k, detail::thread_count_for( k, min_leaves_per_thread, threads ), [&]( std::size_t i ){
+
+            nodes_[ ix[ i ] ] = hash_leaf( p + ix[ i ] * LeafSize, LeafSize );
+
+        });
+
+        if( !built_ ) return;
+
+        for( std::size_t b = 0, w = leaf_count(); w > 1; b += w, w = ( w + 1 ) / 2 )
+        {
+            // the parents of the dirty nodes; ix stays sorted
+
+            std::size_t j = 0;
+
+            for( std::size_t i = 0; i < ix.size(); ++i )
+            {
+                std::size_t q = ix[ i ] / 2;
+
+                if( j == 0 || ix[ j - 1 ] != q )
+                {
+                    ix[ j++ ] = q;
+                }
+            }
+
+            ix.resize( j );
+
+            parallel_for_( ix.size(), detail::thread_count_for( ix.size(), min_nodes_per_thread, threads ), [&]( std::size_t i ){
+
+                std::size_t q = ix[ i ];
+
+                nodes_[ b + w + q ] = 2 * q + 1 < w? hash_node( nodes_[ b + 2 * q ], nodes_[ b + 2 * q + 1 ] ): nodes_[ b + 2 * q ];
+
+            });
+        }
+    }
+
+    void rehash( void const* pv, std::size_t n, std::vector<range> const& dirty, std::size_t threads = 1 )
+    {
+        unsigned char const* p = static_cast<unsigned char const*>( pv );
+        rehash( p, n, dirty, threads );
+    }
+
+    // writes the message length, all leaf and node digests, and the
+    // bytes of the last leaf, if incomplete, to f; returns false when
+    // a write fails
+
+    bool save( std::FILE* f )
+    {
+        build_();
+
+        unsigned char tmp[ file_header_size ] = {};
+
+        tmp[ 0 ] = file_version;
+
+        detail::write64le( tmp + 8, LeafSize );
+        detail::write64le( tmp + 16, sizeof( result_type ) );
+        detail::write64le( tmp + 24, n_ );
+
+        if( std::fwrite( tmp, 1, file_header_size, f ) != file_header_size )
+        {
+            return false;
+        }
+
+        for( std::size_t i = 0; i < nodes_.size(); ++i )
+        {
+            detail::write_result( tmp, sizeof( result_type ), nodes_[ i ] );
+
+            if( std::fwrite( tmp, 1, sizeof( result_type ), f ) != sizeof( result_type ) )
+            {
+                return false;
+            }
+        }
+
+        if( !tail_.empty() && std::fwrite( tail_.data(), 1, tail_.size(), f ) != tail_.size() )
+        {
+            return false;
+        }
+
+        return true;
+    }
+
+    // reads a tree written by save(); returns false, leaving *this
+    // unchanged, when the read fails, the header doesn't match this
+    // tree_hash type, or the nodes aren't consistent with the leaves
+    // and the bytes of the last leaf
+    //
+    // the seed isn't stored, and must be the same as that of *this
+
+    bool load( std::FILE* f )
+    {
+        unsigned char tmp[ file_header_size ];
+
+        if( std::fread( tmp, 1, file_header_size, f ) != file_header_size )
+        {
+            return false;
+        }
+
+        if( tmp[ 0 ] != file_version )
+        {
+            return false;
+        }
+
+        for( int i = 1; i < 8; ++i )
+        {
+            if( tmp[ i ] != 0 ) return false;
+        }
+
+        if( detail::read64le( tmp + 8 ) != LeafSize || detail::read64le( tmp + 16 ) != sizeof( result_type ) )
+        {
+            return false;
+        }
+
+        std::uint64_t const n = detail::read64le( tmp + 24 );
+        std::uint64_t const w = n == 0? 1: ( n - 1 ) / LeafSize + 1;
+        std::uint64_t const m = node_count_( w );
+
+        if( m > static_cast<std::size_t>( -1 ) / sizeof( result_type ) )
+        {
+            return false;
+        }
+
+        // the nodes are read one by one, so that a bogus length
+        // fails at the end of the file rather than in allocation
+
+        std::vector<result_type> nodes;
+
+        for( std::uint64_t i = 0; i < m; ++i )
+        {
+            if( std::fread( tmp, 1, sizeof( result_type ), f ) != sizeof( result_type ) )
+            {
+                return false;
+            }
+
+            nodes.push_back( detail::read_result<result_type>( tmp ) );
+        }
+
+        std::size_t const leaves = static_cast<std::size_t>( n / LeafSize );
+
+        std::vector<unsigned char> tail( static_cast<std::size_t>( n % LeafSize ) );
+
+        if( !tail.empty() && std::fread( tail.data(), 1, tail.size(), f ) != tail.size() )
+        {
+            return false;
+        }
+
+        if( w > leaves && !( nodes[ leaves ] == hash_leaf( tail.data(), tail.size() ) ) )
+        {
+            return false;
+        }
+
+        for( std::size_t b = 0, v = static_cast<std::size_t>( w ); v > 1; b += v, v = ( v + 1 ) / 2 )
+        {
+            for( std::size_t i = 0; i < v; i += 2 )
+            {
+                result_type r = i + 1 < v? hash_node( nodes[ b + i ], nodes[ b + i + 1 ] ): nodes[ b + i ];
+
+                if( !( nodes[ b + v + i / 2 ] == r ) ) return false;
+            }
+        }
+
+        nodes_.swap( nodes );
+        tail_.swap( tail );
+
+        n_ = n;
+        leaves_ = leaves;
+        built_ = true;
+
+        return true;
+    }
+};
+
+#if defined(BOOST_NO_CXX17_INLINE_VARIABLES)
+
+template<class H, std::size_t LeafSize> constexpr std::size_t tree_hash<H, LeafSize>::leaf_size;
+template<class H, std::size_t LeafSize> constexpr unsigned char tree_hash<H, LeafSize>::leaf_prefix;
+template<class H, std::size_t LeafSize> constexpr unsigned char tree_hash<H, LeafSize>::node_prefix;
+template<class H, std::size_t LeafSize> constexpr unsigned char tree_hash<H, LeafSize>::file_version;
+template<class H, std::size_t LeafSize> constexpr std::size_t tree_hash<H, LeafSize>::file_header_size;
+template<class H, std::size_t LeafSize> constexpr std::size_t tree_hash<H, LeafSize>::min_bytes_per_thread;
+template<class H, std::size_t LeafSize> constexpr std::size_t tree_hash<H, LeafSize>::min_leaves_per_thread;
+template<class H, std::size_t LeafSize> constexpr std::size_t tree_hash<H, LeafSize>::min_nodes_per_thread;
+
+#endif
+
+} // namespace hash2
+} // namespace boost
+
+#endif // #ifndef BOOST_HASH2_TREE_HASH_HPP_INCLUDED
@@ -0,0 +1,100 @@
+#ifndef BOOST_HASH2_UPDATE_BUFFERS_HPP_INCLUDED
+#define BOOST_HASH2_UPDATE_BUFFERS_HPP_INCLUDED
+
+// Copyright 2024 Peter Dimov.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <type_traits>
+#include <utility>
+#include <iterator>
+#include <cstddef>
+
+namespace boost
+{
+namespace hash2
+{
+
+namespace detail
+{
+
+// priority tags, so that a type that matches more than one
+// of the buffer forms below is unambiguous
+
+template<int I> struct buffer_priority: buffer_priority<I - 1>
+{
+};
+
+template<> struct buffer_priority<0>
+{
+};
+
+// struct iovec, WSABUF-like { iov_base, iov_len }
+
+template<class B>
+auto buffer_bytes( B const& b, buffer_priority<3> )
+    -> decltype( (void)b.iov_base, (void)b.iov_len, std::pair<void const*, std::size_t>() )
+{
+    return { b.iov_base, static_cast<std::size_t>( b.iov_len ) };
+}
+
+// size in bytes of the element type of a data() pointer;
+// void* is used by buffer types such as boost::asio::const_buffer
+
+template<class P> struct buffer_element_size: std::integral_constant<std::size_t, sizeof( typename std::remove_pointer<P>::type )>
+{
+};
+
+template<> struct buffer_element_size<void*>: std::integral_constant<std::size_t, 1>
+{
+};
+
+template<> struct buffer_element_size<void const*>: std::integral_constant<std::size_t, 1>
+{
+};
+
+// spans, strings, vectors, boost::asio::const_buffer: data(), size()
+
+template<class B>
+auto buffer_bytes( B const& b, buffer_priority<2> )
+    -> decltype( (void)b.data(), (void)b.size(), std::pair<void const*, std::size_t>() )
+{
+    return { b.data(), b.size() * buffer_element_size<decltype( b.data() )>::value };
+}
+
+// std::pair<P, std::size_t>
+
+template<class B>
+auto buffer_bytes( B const& b, buffer_priority<1> )
+    -> decltype( (void)static_cast<void const*>( b.first ), (void)static_cast<std::size_t>( b.second ), std::pair<void const*, std::size_t>() )
+{
+    return { b.first, static_cast<std::size_t>( b.second ) };
+}
+
+} // namespace detail
+
+template<class Hash, class It> void update_buffers( Hash& h, It first, It last )
+{
+    for( ; first != last; ++first )
+    {
+        std::pair<void const*, std::size_t> b = detail::buffer_bytes( *first, detail::buffer_priority<3>() );
+
+        if( b.second != 0 )
+        {
+            h.update( b.first, b.second );
+        }
+    }
+}
+
+template<class Hash, class R> void update_buffers( Hash& h, R const& r )
+{
+    using std::begin;
+    using std::end;
+
+    hash2::update_buffers( h, begin( r ), end( r ) );
+}
+
+} // namespace hash2
+} // namespace boost
+
+#endif // #ifndef BOOST_HASH2_UPDATE_BUFFERS_HPP_INCLUDED
@@ -45,9 +45,12 @@ private:
     std::uint32_t v4_ = static_cast<std::uint32_t>( 0 ) - P1;
 
     unsigned char buffer_[ 16 ] = {};
-    std::size_t m_ = 0; // == n_ % 16
 
-    std::size_t n_ = 0;
+    // as in the reference implementation, the length is kept mod 2^32,
+    // with a separate flag for whether 16 bytes or more have been hashed
+
+    std::uint32_t n_ = 0;
+    bool large_ = false;
 
 private:
 
@@ -59,6 +62,14 @@ private:
         v4_ = seed - P1;
     }
 
+    BOOST_CXX14_CONSTEXPR void clear_()
+    {
+        n_ = 0;
+        large_ = false;
+
+        detail::memset( buffer_, 0, 16 );
+    }
+
     BOOST_CXX14_CONSTEXPR static std::uint32_t round( std::uint32_t seed, std::uint32_t input )
     {
         seed += input * P2;
@@ -88,13 +99,54 @@ private:
         v4_ = v4; 
     }
 
-public:
+    BOOST_CXX14_CONSTEXPR std::uint32_t digest_( unsigned char const* p, std::size_t m ) const
+    {
+        std::uint32_t h = 0;
 
-    using result_type = std::uint32_t;
+        if( large_ )
+        {
+            h = detail::rotl( v1_, 1 ) + detail::rotl( v2_, 7 ) + detail::rotl( v3_, 12 ) + detail::rotl( v4_, 18 );
+        }
+        else
+        {
+            h = v3_ + P5;
+        }
 
-    xxhash_32() = default;
+        h += n_;
 
-    BOOST_CXX14_CONSTEXPR explicit xxhash_32( std::uint64_t seed )
+        while( m >= 4 )
+        {
+            h += detail::read32le( p ) * P3;
+            h = detail::rotl( h, 17 ) * P4;
+
+            p += 4;
+            m -= 4;
+        }
+
+        while( m > 0 )
+        {
+            h += p[0] * P5;
+            h = detail::rotl( h, 11 ) * P1;
+
+            ++p;
+            --m;
+        }
+
+        return h;
+    }
+
+    BOOST_CXX14_CONSTEXPR static std::uint32_t avalanche_( std::uint32_t h )
+    {
+        h ^= h >> 15;
+        h *= P2;
+        h ^= h >> 13;
+        h *= P3;
+        h ^= h >> 16;
+
+        return h;
+    }
+
+    BOOST_CXX14_CONSTEXPR void seed_( std::uint64_t seed )
     {
         std::uint32_t s0 = static_cast<std::uint32_t>( seed );
         std::uint32_t s1 = static_cast<std::uint32_t>( seed >> 32 );
@@ -110,7 +162,7 @@ public:
         }
     }
 
-    BOOST_CXX14_CONSTEXPR xxhash_32( unsigned char const * p, std::size_t n )
+    BOOST_CXX14_CONSTEXPR void seed_( unsigned char const * p, std::size_t n )
     {
         if( n != 0 )
         {
@@ -119,38 +171,69 @@ public:
         }
     }
 
-    BOOST_CXX14_CONSTEXPR void update( unsigned char const* p, std::size_t n )
+public:
+
+    using result_type = std::uint32_t;
+
+    xxhash_32() = default;
+
+    BOOST_CXX14_CONSTEXPR explicit xxhash_32( std::uint64_t seed )
+    {
+        seed_( seed );
+    }
+
+    BOOST_CXX14_CONSTEXPR xxhash_32( unsigned char const * p, std::size_t n )
+    {
+        seed_( p, n );
+    }
+
+    BOOST_CXX14_CONSTEXPR void reseed( std::uint64_t seed )
+    {
+        clear_();
+        seed_( seed );
+    }
+
+    BOOST_CXX14_CONSTEXPR void reseed( unsigned char const * p, std::size_t n )
     {
-        BOOST_ASSERT( m_ == n_ % 16 );
+        clear_();
+        init( 0 );
 
+        seed_( p, n );
+    }
+
+    BOOST_CXX14_CONSTEXPR void update( unsigned char const* p, std::size_t n )
+    {
         if( n == 0 ) return;
 
-        n_ += n;
+        std::size_t m = n_ % 16;
+
+        n_ += static_cast<std::uint32_t>( n );
+        large_ = large_ || n >= 16 || n_ >= 16;
 
-        if( m_ > 0 )
+        if( m > 0 )
         {
-            std::size_t k = 16 - m_;
+            std::size_t k = 16 - m;
 
             if( n < k )
             {
                 k = n;
             }
 
-            detail::memcpy( buffer_ + m_, p, k );
+            detail::memcpy( buffer_ + m, p, k );
 
             p += k;
             n -= k;
-            m_ += k;
+            m += k;
 
-            if( m_ < 16 ) return;
+            if( m < 16 ) return;
 
-            BOOST_ASSERT( m_ == 16 );
+            BOOST_ASSERT( m == 16 );
 
             update_( buffer_, 1 );
-            m_ = 0;
+            m = 0;
         }
 
-        BOOST_ASSERT( m_ == 0 );
+        BOOST_ASSERT( m == 0 );
 
         {
             std::size_t k = n / 16;
@@ -166,10 +249,7 @@ public:
         if( n > 0 )
         {
             detail::memcpy( buffer_, p, n );
-            m_ = n;
         }
-
-        BOOST_ASSERT( m_ == n_ % 16 );
     }
 
     void update( void const* pv, std::size_t n )
@@ -178,47 +258,35 @@ public:
         update( p, n );
     }
 
-    BOOST_CXX14_CONSTEXPR std::uint32_t result()
+    template<std::size_t K> BOOST_CXX14_CONSTEXPR void update( unsigned char const* p )
     {
-        BOOST_ASSERT( m_ == n_ % 16 );
-
-        std::uint32_t h = 0;
-
-        if( n_ >= 16 )
+        if( n_ % 16 != 0 )
         {
-            h = detail::rotl( v1_, 1 ) + detail::rotl( v2_, 7 ) + detail::rotl( v3_, 12 ) + detail::rotl( v4_, 18 );
-        }
-        else
-        {
-            h = v3_ + P5;
+            update( p, K );
+            return;
         }
 
-        h += static_cast<std::uint32_t>( n_ );
+        // block-aligned state; the block count and the tail size are constants
 
-        unsigned char const * p = buffer_;
+        n_ += static_cast<std::uint32_t>( K );
+        large_ = large_ || K >= 16 || n_ >= 16;
 
-        std::size_t m = m_;
+        update_( p, K / 16 );
 
-        while( m >= 4 )
+        if( K % 16 != 0 )
         {
-            h += detail::read32le( p ) * P3;
-            h = detail::rotl( h, 17 ) * P4;
-
-            p += 4;
-            m -= 4;
+            detail::memcpy( buffer_, p + K / 16 * 16, K % 16 );
         }
+    }
 
-        while( m > 0 )
-        {
-            h += p[0] * P5;
-            h = detail::rotl( h, 11 ) * P1;
+    BOOST_CXX14_CONSTEXPR std::uint32_t result()
+    {
+        std::size_t m = n_ % 16;
 
-            ++p;
-            --m;
-        }
+        std::uint32_t h = digest_( buffer_, m );
 
-        n_ += 16 - m_;
-        m_ = 0;
+        n_ += static_cast<std::uint32_t>( 16 - m );
+        large_ = true;
 
         // clear buffered plaintext
         detail::memset( buffer_, 0, 16 );
@@ -230,13 +298,21 @@ public:
         v4_ -= h;
 
         // apply final mix
-        h ^= h >> 15;
-        h *= P2;
-        h ^= h >> 13;
-        h *= P3;
-        h ^= h >> 16;
+        return avalanche_( h );
+    }
 
-        return h;
+    // one-shot; equivalent to xxhash_32 h( seed ); h.update( p, n ); return h.result();
+    // but the tail is read directly from [p, p+n) instead of going through buffer_
+
+    BOOST_CXX14_CONSTEXPR static std::uint32_t hash( unsigned char const* p, std::size_t n, std::uint64_t seed )
+    {
+        xxhash_32 h( seed );
+
+        h.update_( p, n / 16 );
+        h.n_ = static_cast<std::uint32_t>( n );
+        h.large_ = n >= 16;
+
+        return avalanche_( h.digest_( p + n / 16 * 16, n % 16 ) );
     }
 };
 
@@ -258,7 +334,6 @@ private:
     std::uint64_t v4_ = static_cast<std::uint64_t>( 0 ) - P1;
 
     unsigned char buffer_[ 32 ] = {};
-    std::size_t m_ = 0; // == n_ % 32
 
     std::uint64_t n_ = 0;
 
@@ -272,6 +347,13 @@ private:
         v4_ = seed - P1;
     }
 
+    BOOST_CXX14_CONSTEXPR void clear_()
+    {
+        n_ = 0;
+
+        detail::memset( buffer_, 0, 32 );
+    }
+
     BOOST_CXX14_CONSTEXPR static std::uint64_t round( std::uint64_t seed, std::uint64_t input )
     {
         seed += input * P2;
@@ -309,18 +391,75 @@ private:
         v4_ = v4; 
     }
 
-public:
+    BOOST_CXX14_CONSTEXPR std::uint64_t digest_( unsigned char const* p, std::size_t m ) const
+    {
+        std::uint64_t h = 0;
 
-    typedef std::uint64_t result_type;
+        if( n_ >= 32 )
+        {
+            h = detail::rotl( v1_, 1 ) + detail::rotl( v2_, 7 ) + detail::rotl( v3_, 12 ) + detail::rotl( v4_, 18 );
 
-    xxhash_64() = default;
+            h = merge_round( h, v1_ );
+            h = merge_round( h, v2_ );
+            h = merge_round( h, v3_ );
+            h = merge_round( h, v4_ );
+        }
+        else
+        {
+            h = v3_ + P5;
+        }
 
-    BOOST_CXX14_CONSTEXPR explicit xxhash_64( std::uint64_t seed )
+        h += n_;
+
+        while( m >= 8 )
+        {
+            std::uint64_t k1 = round( 0, detail::read64le( p ) );
+
+            h ^= k1;
+            h = detail::rotl( h, 27 ) * P1 + P4;
+
+            p += 8;
+            m -= 8;
+        }
+
+        while( m >= 4 )
+        {
+            h ^= static_cast<std::uint64_t>( detail::read32le( p ) ) * P1;
+            h = detail::rotl( h, 23 ) * P2 + P3;
+
+            p += 4;
+            m -= 4;
+        }
+
+        while( m > 0 )
+        {
+            h ^= p[0] * P5;
+            h = detail::rotl( h, 11 ) * P1;
+
+            ++p;
+            --m;
+        }
+
+        return h;
+    }
+
+    BOOST_CXX14_CONSTEXPR static std::uint64_t avalanche_( std::uint64_t h )
+    {
+        h ^= h >> 33;
+        h *= P2;
+        h ^= h >> 29;
+        h *= P3;
+        h ^= h >> 32;
+
+        return h;
+    }
+
+    BOOST_CXX14_CONSTEXPR void seed_( std::uint64_t seed )
     {
         init( seed );
     }
 
-    BOOST_CXX14_CONSTEXPR xxhash_64( unsigned char const * p, std::size_t n )
+    BOOST_CXX14_CONSTEXPR void seed_( unsigned char const * p, std::size_t n )
     {
         if( n != 0 )
         {
@@ -329,38 +468,68 @@ public:
         }
     }
 
-    BOOST_CXX14_CONSTEXPR void update( unsigned char const* p, std::size_t n )
+public:
+
+    typedef std::uint64_t result_type;
+
+    xxhash_64() = default;
+
+    BOOST_CXX14_CONSTEXPR explicit xxhash_64( std::uint64_t seed )
+    {
+        seed_( seed );
+    }
+
+    BOOST_CXX14_CONSTEXPR xxhash_64( unsigned char const * p, std::size_t n )
     {
-        BOOST_ASSERT( m_ == n_ % 32 );
+        seed_( p, n );
+    }
 
+    BOOST_CXX14_CONSTEXPR void reseed( std::uint64_t seed )
+    {
+        clear_();
+        seed_( seed );
+    }
+
+    BOOST_CXX14_CONSTEXPR void reseed( unsigned char const * p, std::size_t n )
+    {
+        clear_();
+        init( 0 );
+
+        seed_( p, n );
+    }
+
+    BOOST_CXX14_CONSTEXPR void update( unsigned char const* p, std::size_t n )
+    {
         if( n == 0 ) return;
 
+        std::size_t m = static_cast<std::size_t>( n_ % 32 );
+
         n_ += n;
 
-        if( m_ > 0 )
+        if( m > 0 )
         {
-            std::size_t k = 32 - m_;
+            std::size_t k = 32 - m;
 
             if( n < k )
             {
                 k = n;
             }
 
-            detail::memcpy( buffer_ + m_, p, k );
+            detail::memcpy( buffer_ + m, p, k );
 
             p += k;
             n -= k;
-            m_ += k;
+            m += k;
 
-            if( m_ < 32 ) return;
+            if( m < 32 ) return;
 
-            BOOST_ASSERT( m_ == 32 );
+            BOOST_ASSERT( m == 32 );
 
             update_( buffer_, 1 );
-            m_ = 0;
+            m = 0;
         }
 
-        BOOST_ASSERT( m_ == 0 );
+        BOOST_ASSERT( m == 0 );
 
         {
             std::size_t k = n / 32;
@@ -376,10 +545,7 @@ public:
         if( n > 0 )
         {
             detail::memcpy( buffer_, p, n );
-            m_ = n;
         }
-
-        BOOST_ASSERT( m_ == n_ % 32 );
     }
 
     void update( void const* pv, std::size_t n )
@@ -388,63 +554,33 @@ public:
         update( p, n );
     }
 
-    BOOST_CXX14_CONSTEXPR std::uint64_t result()
+    template<std::size_t K> BOOST_CXX14_CONSTEXPR void update( unsigned char const* p )
     {
-        BOOST_ASSERT( m_ == n_ % 32 );
-
-        std::uint64_t h = 0;
-
-        if( n_ >= 32 )
-        {
-            h = detail::rotl( v1_, 1 ) + detail::rotl( v2_, 7 ) + detail::rotl( v3_, 12 ) + detail::rotl( v4_, 18 );
-
-            h = merge_round( h, v1_ );
-            h = merge_round( h, v2_ );
-            h = merge_round( h, v3_ );
-            h = merge_round( h, v4_ );
-        }
-        else
+        if( n_ % 32 != 0 )
         {
-            h = v3_ + P5;
+            update( p, K );
+            return;
         }
 
-        h += n_;
-
-        unsigned char const * p = buffer_;
-
-        std::size_t m = m_;
-
-        while( m >= 8 )
-        {
-            std::uint64_t k1 = round( 0, detail::read64le( p ) );
+        // block-aligned state; the block count and the tail size are constants
 
-            h ^= k1;
-            h = detail::rotl( h, 27 ) * P1 + P4;
+        n_ += K;
 
-            p += 8;
-            m -= 8;
-        }
+        update_( p, K / 32 );
 
-        while( m >= 4 )
+        if( K % 32 != 0 )
         {
-            h ^= static_cast<std::uint64_t>( detail::read32le( p ) ) * P1;
-            h = detail::rotl( h, 23 ) * P2 + P3;
-
-            p += 4;
-            m -= 4;
+            detail::memcpy( buffer_, p + K / 32 * 32, K % 32 );
         }
+    }
 
-        while( m > 0 )
-        {
-            h ^= p[0] * P5;
-            h = detail::rotl( h, 11 ) * P1;
+    BOOST_CXX14_CONSTEXPR std::uint64_t result()
+    {
+        std::size_t m = static_cast<std::size_t>( n_ % 32 );
 
-            ++p;
-            --m;
-        }
+        std::uint64_t h = digest_( buffer_, m );
 
-        n_ += 32 - m_;
-        m_ = 0;
+        n_ += 32 - m;
 
         // clear buffered plaintext
         detail::memset( buffer_, 0, 32 );
@@ -456,13 +592,20 @@ public:
         v4_ -= h;
 
         // apply final mix
-        h ^= h >> 33;
-        h *= P2;
-        h ^= h >> 29;
-        h *= P3;
-        h ^= h >> 32;
+        return avalanche_( h );
+    }
 
-        return h;
+    // one-shot; equivalent to xxhash_64 h( seed ); h.update( p, n ); return h.result();
+    // but the tail is read directly from [p, p+n) instead of going through buffer_
+
+    BOOST_CXX14_CONSTEXPR static std::uint64_t hash( unsigned char const* p, std::size_t n, std::uint64_t seed )
+    {
+        xxhash_64 h( seed );
+
+        h.update_( p, n / 32 );
+        h.n_ = n;
+
+        return avalanche_( h.digest_( p + n / 32 * 32, n % 32 ) );
     }
 };
 
@@ -0,0 +1,163 @@
+// Copyright 2024 Peter Dimov.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/hash2/hash_append.hpp>
+#include <boost/hash2/fnv1a.hpp>
+#include <boost/hash2/xxhash.hpp>
+#include <boost/hash2/sha2.hpp>
+#include <boost/dynamic_bitset.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+
+// counts the calls to update
+
+template<class H> class counting: public H
+{
+public:
+
+    std::size_t calls = 0;
+
+    void update( void const* p, std::size_t n )
+    {
+        ++calls;
+        H::update( p, n );
+    }
+};
+
+template<class Hash, class Flavor, std::size_t N> void test_bitset()
+{
+    std::bitset<N> v;
+
+    for( std::size_t i = 0; i < N; i += 1 + i / 5 )
+    {
+        v.set( i );
+    }
+
+    Hash h1;
+
+    if( N == 0 )
+    {
+        hash_append( h1, Flavor(), '\x00' );
+    }
+    else
+    {
+        for( std::size_t i = 0; i < N; i += 64 )
+        {
+            std::uint64_t w = 0;
+
+            for( std::size_t j = 0; j < 64 && i + j < N; ++j )
+            {
+                if( v.test( i + j ) ) w |= std::uint64_t( 1 ) << j;
+            }
+
+            hash_append( h1, Flavor(), w );
+        }
+    }
+
+    Hash h2;
+    hash_append( h2, Flavor(), v );
+
+    BOOST_TEST( h1.result() == h2.result() );
+
+    if( N > 0 )
+    {
+        std::bitset<N> v2( v );
+        v2.flip( N - 1 );
+
+        Hash h3;
+        hash_append( h3, Flavor(), v2 );
+
+        BOOST_TEST( h2.result() != h3.result() );
+    }
+}
+
+template<class Hash, class Flavor, class Block> void test_dynamic_bitset( std::size_t n )
+{
+    boost::dynamic_bitset<Block> v( n );
+
+    for( std::size_t i = 0; i < n; i += 1 + i / 3 )
+    {
+        v.set( i );
+    }
+
+    Hash h1;
+
+    for( std::size_t i = 0; i < v.num_blocks(); ++i )
+    {
+        Block w = 0;
+
+        for( std::size_t j = 0; j < v.bits_per_block && i * v.bits_per_block + j < n; ++j )
+        {
+            if( v.test( i * v.bits_per_block + j ) ) w = static_cast<Block>( w | ( Block( 1 ) << j ) );
+        }
+
+        hash_append( h1, Flavor(), w );
+    }
+
+    hash_append_size( h1, Flavor(), n );
+
+    Hash h2;
+    hash_append( h2, Flavor(), v );
+
+    BOOST_TEST( h1.result() == h2.result() );
+}
+
+template<class Hash, class Flavor> void test()
+{
+    test_bitset<Hash, Flavor, 0>();
+    test_bitset<Hash, Flavor, 1>();
+    test_bitset<Hash, Flavor, 7>();
+    test_bitset<Hash, Flavor, 63>();
+    test_bitset<Hash, Flavor, 64>();
+    test_bitset<Hash, Flavor, 65>();
+    test_bitset<Hash, Flavor, 128>();
+    test_bitset<Hash, Flavor, 4096>();
+    test_bitset<Hash, Flavor, 5000>();
+    test_bitset<Hash, Flavor, 1 << 16>();
+
+    std::size_t const sizes[] = { 0, 1, 7, 8, 31, 32, 33, 64, 100, 4096, 5000 };
+
+    for( std::size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i )
+    {
+        test_dynamic_bitset<Hash, Flavor, unsigned char>( sizes[ i ] );
+        test_dynamic_bitset<Hash, Flavor, std::uint16_t>( sizes[ i ] );
+        test_dynamic_bitset<Hash, Flavor, std::uint32_t>( sizes[ i ] );
+        test_dynamic_bitset<Hash, Flavor, unsigned long>( sizes[ i ] );
+        test_dynamic_bitset<Hash, Flavor, unsigned long long>( sizes[ i ] );
+    }
+}
+
+int main()
+{
+    using namespace boost::hash2;
+
+    test<fnv1a_32, default_flavor>();
+    test<fnv1a_64, little_endian_flavor>();
+    test<xxhash_64, big_endian_flavor>();
+    test<sha2_256, default_flavor>();
+
+    // the words are passed to update in large chunks, not one at a time
+
+    {
+        std::bitset<4096> v;
+
+        counting<fnv1a_64> h;
+        hash_append( h, {}, v );
+
+        BOOST_TEST_LE( h.calls, 1u );
+    }
+
+    {
+        boost::dynamic_bitset<std::uint64_t> v( 4096 );
+
+        counting<fnv1a_64> h;
+        hash_append( h, {}, v );
+
+        BOOST_TEST_LE( h.calls, 2u );
+    }
+
+    return boost::report_errors();
+}
@@ -0,0 +1,157 @@
+// Copyright 2024 Peter Dimov.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/hash2/ascii_case_insensitive.hpp>
+#include <boost/hash2/hash_append.hpp>
+#include <boost/hash2/get_integral_result.hpp>
+#include <boost/hash2/fnv1a.hpp>
+#include <boost/hash2/xxhash.hpp>
+#include <boost/hash2/siphash.hpp>
+#include <boost/hash2/sha2.hpp>
+#include <boost/utility/string_view.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <unordered_set>
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+static std::string lower( std::string s )
+{
+    for( std::size_t i = 0; i < s.size(); ++i )
+    {
+        if( s[ i ] >= 'A' && s[ i ] <= 'Z' ) s[ i ] = static_cast<char>( s[ i ] - 'A' + 'a' );
+    }
+
+    return s;
+}
+
+static void test_swar()
+{
+    using boost::hash2::detail::ascii_lower;
+
+    for( int i = 0; i < 256; ++i )
+    {
+        unsigned char ch = static_cast<unsigned char>( i );
+        unsigned char r = ( ch >= 'A' && ch <= 'Z' )? static_cast<unsigned char>( ch + 32 ): ch;
+
+        BOOST_TEST_EQ( ascii_lower( ch ), r );
+
+        for( int j = 0; j < 8; ++j )
+        {
+            // every byte value in every position, next to bytes that could carry into it
+
+            std::uint64_t w = 0xFF40415A5B607A7Bull ^ ( 0xFFull << ( j * 8 ) );
+            w |= static_cast<std::uint64_t>( ch ) << ( j * 8 );
+
+            std::uint64_t w2 = ascii_lower( w );
+
+            for( int k = 0; k < 8; ++k )
+            {
+                unsigned char b = static_cast<unsigned char>( w >> ( k * 8 ) );
+                unsigned char b2 = static_cast<unsigned char>( w2 >> ( k * 8 ) );
+
+                BOOST_TEST_EQ( b2, ascii_lower( b ) );
+            }
+        }
+    }
+}
+
+template<class H, class Flavor> void test()
+{
+    std::string s;
+
+    for( std::size_t i = 0; i < 300; ++i )
+    {
+        std::string const t = lower( s );
+
+        H h1( 7 );
+        hash_append( h1, Flavor(), t );
+
+        typename H::result_type r = h1.result();
+
+        {
+            H h2( 7 );
+            boost::hash2::hash_append_ascii_lower( h2, Flavor(), s );
+
+            BOOST_TEST( h2.result() == r );
+        }
+
+        {
+            H h2( 7 );
+            boost::hash2::hash_append_ascii_lower( h2, Flavor(), s.c_str() );
+
+            BOOST_TEST( h2.result() == r );
+        }
+
+        {
+            H h2( 7 );
+            boost::hash2::hash_append_ascii_lower( h2, Flavor(), boost::string_view( s ) );
+
+            BOOST_TEST( h2.result() == r );
+        }
+
+        {
+            boost::hash2::ascii_case_insensitive_hasher<H, Flavor> hf( 7 );
+
+            std::size_t r2 = boost::hash2::get_integral_result<std::size_t>( r );
+
+            BOOST_TEST_EQ( hf( s ), r2 );
+            BOOST_TEST_EQ( hf( t ), r2 );
+            BOOST_TEST_EQ( hf( s.c_str() ), r2 );
+        }
+
+        // mixed case letters, punctuation in the upper/lower boundary ranges, and non-ASCII bytes
+        char const alphabet[] = "AbCdEfGhIjKlMnOpQrStUvWxYz@[`{-_0\xC0\xDA\xFF";
+        s += alphabet[ ( i * 7 ) % ( sizeof(alphabet) - 1 ) ];
+    }
+}
+
+template<class H> void test_container()
+{
+    using namespace boost::hash2;
+
+    using hasher = ascii_case_insensitive_hasher<H>;
+    using equal_to = ascii_case_insensitive_equal_to;
+
+    std::unordered_set<std::string, hasher, equal_to> st( 0, hasher( 42 ) );
+
+    st.insert( "Content-Type" );
+    st.insert( "content-type" );
+    st.insert( "CONTENT-TYPE" );
+    st.insert( "Content-Length" );
+
+    BOOST_TEST_EQ( st.size(), 2u );
+    BOOST_TEST_EQ( st.count( "content-TYPE" ), 1u );
+    BOOST_TEST_EQ( st.count( "CONTENT-LENGTH" ), 1u );
+    BOOST_TEST_EQ( st.count( "Content-Encoding" ), 0u );
+}
+
+int main()
+{
+    using namespace boost::hash2;
+
+    test_swar();
+
+    {
+        ascii_case_insensitive_equal_to eq;
+
+        BOOST_TEST( eq( "Host", std::string( "hOST" ) ) );
+        BOOST_TEST( eq( boost::string_view( "WWW.Example.COM" ), "www.example.com" ) );
+        BOOST_TEST( !eq( "Host", "Hosts" ) );
+        BOOST_TEST( !eq( "[", "{" ) );
+        BOOST_TEST( !eq( "@", "`" ) );
+    }
+
+    test<fnv1a_32, default_flavor>();
+    test<fnv1a_64, default_flavor>();
+    test<xxhash_64, little_endian_flavor>();
+    test<siphash_64, big_endian_flavor>();
+    test<sha2_256, default_flavor>();
+
+    test_container<fnv1a_64>();
+    test_container<siphash_64>();
+
+    return boost::report_errors();
+}
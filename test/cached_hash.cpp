@@ -0,0 +1,163 @@
+// Copyright 2024 Peter Dimov.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/hash2/cached_hash.hpp>
+#include <boost/hash2/hash_append.hpp>
+#include <boost/hash2/fnv1a.hpp>
+#include <boost/hash2/xxhash.hpp>
+#include <boost/hash2/siphash.hpp>
+#include <boost/hash2/md5.hpp>
+#include <boost/hash2/sha2.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/core/lightweight_test_trait.hpp>
+#include <string>
+#include <vector>
+#include <utility>
+
+struct X
+{
+    std::string a;
+    std::vector<int> b;
+
+    // counts the traversals of X
+    static int calls;
+
+    friend bool operator==( X const& x1, X const& x2 )
+    {
+        return x1.a == x2.a && x1.b == x2.b;
+    }
+};
+
+int X::calls = 0;
+
+template<class Hash, class Flavor>
+void tag_invoke( boost::hash2::hash_append_tag const&, Hash& h, Flavor const& f, X const& x )
+{
+    ++X::calls;
+
+    boost::hash2::hash_append( h, f, x.a );
+    boost::hash2::hash_append( h, f, x.b );
+}
+
+template<class H, class Flavor, class Outer> void test()
+{
+    using boost::hash2::cached_hash;
+
+    using C = cached_hash<X, H, Flavor>;
+
+    BOOST_TEST_TRAIT_TRUE((std::is_same<typename C::hash_type, H>));
+    BOOST_TEST_TRAIT_TRUE((std::is_same<typename C::flavor_type, Flavor>));
+    BOOST_TEST_TRAIT_TRUE((std::is_same<typename C::result_type, typename H::result_type>));
+
+    X const x = { "some fairly long string, to make the traversal non-trivial", { 1, 2, 3, 4, 5 } };
+
+    X::calls = 0;
+
+    C const c( x );
+
+    BOOST_TEST_EQ( X::calls, 1 );
+    BOOST_TEST( c.value() == x );
+
+    {
+        H h;
+        hash_append( h, Flavor(), x );
+
+        BOOST_TEST( c.digest() == h.result() );
+    }
+
+    X::calls = 0;
+
+    // hash_append of a cached_hash appends the digest, with the outer flavor
+
+    for( int i = 0; i < 3; ++i )
+    {
+        Outer h1( 7 ), h2( 7 );
+
+        hash_append( h1, boost::hash2::big_endian_flavor(), c );
+        hash_append( h2, boost::hash2::big_endian_flavor(), c.digest() );
+
+        BOOST_TEST( h1.result() == h2.result() );
+    }
+
+    BOOST_TEST_EQ( X::calls, 0 );
+
+    // as a part of an enclosing object
+
+    {
+        std::vector<C> v;
+
+        v.push_back( c );
+        v.push_back( C( X{ "", {} } ) );
+
+        X::calls = 0;
+
+        Outer h1, h2;
+
+        hash_append( h1, {}, v );
+
+        hash_append( h2, {}, v[0].digest() );
+        hash_append( h2, {}, v[1].digest() );
+        hash_append_size( h2, {}, v.size() );
+
+        BOOST_TEST( h1.result() == h2.result() );
+        BOOST_TEST_EQ( X::calls, 0 );
+    }
+
+    // comparisons
+
+    {
+        X x2( x );
+
+        C const c2( std::move( x2 ) );
+
+        BOOST_TEST( c == c2 );
+        BOOST_TEST( !( c != c2 ) );
+
+        X x3( x );
+        x3.b.push_back( 6 );
+
+        C const c3( x3 );
+
+        BOOST_TEST( c != c3 );
+    }
+
+    // a seeded digest
+
+    {
+        X::calls = 0;
+
+        H const h0( 5 );
+
+        C const c2( x, h0 );
+
+        X x2( x );
+        C const c3( std::move( x2 ), h0 );
+
+        BOOST_TEST_EQ( X::calls, 2 );
+
+        H h( 5 );
+        hash_append( h, Flavor(), x );
+
+        typename H::result_type const r = h.result();
+
+        BOOST_TEST( c2.digest() == r );
+        BOOST_TEST( c3.digest() == r );
+
+        BOOST_TEST( c2.digest() != c.digest() );
+
+        BOOST_TEST( c2 == c3 );
+    }
+}
+
+int main()
+{
+    using namespace boost::hash2;
+
+    test<fnv1a_64, default_flavor, xxhash_64>();
+    test<xxhash_64, little_endian_flavor, siphash_64>();
+    test<md5_128, default_flavor, xxhash_64>();
+    test<sha2_256, big_endian_flavor, sha2_256>();
+
+    return boost::report_errors();
+}
@@ -0,0 +1,251 @@
+// Copyright 2024 Peter Dimov.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/hash2/fastcdc.hpp>
+#include <boost/hash2/sha2.hpp>
+#include <boost/hash2/xxhash.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <algorithm>
+#include <vector>
+#include <stdexcept>
+#include <cstddef>
+#include <cstdint>
+
+std::vector<unsigned char> data( 1 << 20 );
+
+template<class C> std::vector<typename C::chunk> chunk_all( C c, unsigned char const* p, std::size_t n, std::size_t step )
+{
+    for( std::size_t i = 0; i < n; i += step )
+    {
+        c.update( p + i, std::min( step, n - i ) );
+    }
+
+    c.finish();
+
+    BOOST_TEST_EQ( c.size(), n );
+
+    return c.chunks();
+}
+
+template<class C> void test_layout( C const& c0, std::size_t n )
+{
+    std::vector<typename C::chunk> v = chunk_all( c0, data.data(), n, n + 1 );
+
+    std::uint64_t offset = 0;
+
+    for( std::size_t i = 0; i < v.size(); ++i )
+    {
+        BOOST_TEST_EQ( v[ i ].offset, offset );
+
+        BOOST_TEST_LE( v[ i ].size, c0.max_size() );
+        BOOST_TEST_GT( v[ i ].size, 0u );
+
+        if( i + 1 < v.size() )
+        {
+            BOOST_TEST_GE( v[ i ].size, c0.min_size() );
+        }
+
+        offset += v[ i ].size;
+    }
+
+    BOOST_TEST_EQ( offset, n );
+
+    // the boundaries don't depend on how the stream is split
+
+    std::size_t const steps[] = { 1, 7, 64, 1000, 4096, 65537 };
+
+    for( std::size_t k = 0; k < sizeof(steps) / sizeof(steps[0]); ++k )
+    {
+        if( steps[ k ] < 64 && n > 100000 ) continue;
+
+        std::vector<typename C::chunk> w = chunk_all( c0, data.data(), n, steps[ k ] );
+
+        BOOST_TEST_EQ( w.size(), v.size() );
+
+        for( std::size_t i = 0; i < v.size() && i < w.size(); ++i )
+        {
+            BOOST_TEST_EQ( w[ i ].offset, v[ i ].offset );
+            BOOST_TEST_EQ( w[ i ].size, v[ i ].size );
+        }
+    }
+}
+
+template<class H> void test_digest()
+{
+    using C = boost::hash2::fastcdc<H>;
+
+    C c( 1024, 4096, 16384 );
+
+    std::vector<typename C::chunk> v = chunk_all( c, data.data(), data.size(), 10000 );
+
+    for( std::size_t i = 0; i < v.size(); ++i )
+    {
+        H h;
+        h.update( data.data() + v[ i ].offset, v[ i ].size );
+
+        BOOST_TEST( v[ i ].digest == h.result() );
+    }
+}
+
+template<class H> void test_shift()
+{
+    using C = boost::hash2::fastcdc<H>;
+
+    // inserting bytes at the start only changes the first chunks
+
+    std::vector<unsigned char> w( data.begin(), data.begin() + 100 );
+    w.insert( w.end(), data.begin(), data.end() );
+
+    C c( 5 );
+
+    std::vector<typename C::chunk> v1 = chunk_all( c, data.data(), data.size(), 65536 );
+    std::vector<typename C::chunk> v2 = chunk_all( c, w.data(), w.size(), 65536 );
+
+    std::size_t common = 0;
+
+    for( std::size_t i = 0; i < v2.size(); ++i )
+    {
+        for( std::size_t j = 0; j < v1.size(); ++j )
+        {
+            if( v1[ j ].offset + 100 == v2[ i ].offset && v1[ j ].size == v2[ i ].size && v1[ j ].digest == v2[ i ].digest )
+            {
+                ++common;
+                break;
+            }
+        }
+    }
+
+    BOOST_TEST_GE( common + 3, v1.size() );
+}
+
+int main()
+{
+    std::uint32_t x = 0x9E3779B9u;
+
+    for( std::size_t i = 0; i < data.size(); ++i )
+    {
+        x = x * 1664525u + 1013904223u;
+        data[ i ] = static_cast<unsigned char>( x >> 24 );
+    }
+
+    using namespace boost::hash2;
+
+    {
+        fastcdc<> c;
+
+        BOOST_TEST_EQ( c.min_size(), 2048u );
+        BOOST_TEST_EQ( c.avg_size(), 8192u );
+        BOOST_TEST_EQ( c.max_size(), 65536u );
+
+        test_layout( c, 0 );
+        test_layout( c, 1 );
+        test_layout( c, 2048 );
+        test_layout( c, 100000 );
+        test_layout( c, data.size() );
+    }
+
+    test_layout( fastcdc<>( 7 ), data.size() );
+    test_layout( fastcdc<>( data.data(), 16 ), data.size() );
+    test_layout( fastcdc<>( 64, 256, 1024 ), 100000 );
+    test_layout( fastcdc<>( 3, 100, 200, 300 ), 100000 );
+
+    // fixed size chunks
+    test_layout( fastcdc<>( 1000, 1000, 1000 ), 100000 );
+
+    {
+        // fixed size chunks when min_size == max_size
+
+        fastcdc<> c( 1000, 1000, 1000 );
+
+        std::vector<fastcdc<>::chunk> v = chunk_all( c, data.data(), 10500, 333 );
+
+        BOOST_TEST_EQ( v.size(), 11u );
+
+        for( std::size_t i = 0; i < v.size(); ++i )
+        {
+            BOOST_TEST_EQ( v[ i ].size, i < 10? 1000u: 500u );
+        }
+    }
+
+    {
+        // the average chunk size on random data is near avg_size
+
+        fastcdc<> c( 11 );
+
+        std::vector<fastcdc<>::chunk> v = chunk_all( c, data.data(), data.size(), 65536 );
+
+        std::size_t avg = data.size() / v.size();
+
+        BOOST_TEST_GE( avg, c.avg_size() / 2 );
+        BOOST_TEST_LE( avg, c.avg_size() * 2 );
+    }
+
+    {
+        // different seeds give different boundaries
+
+        std::vector<fastcdc<>::chunk> v1 = chunk_all( fastcdc<>( 1 ), data.data(), data.size(), 65536 );
+        std::vector<fastcdc<>::chunk> v2 = chunk_all( fastcdc<>( 2 ), data.data(), data.size(), 65536 );
+
+        BOOST_TEST( v1.size() != v2.size() || v1[ 0 ].size != v2[ 0 ].size );
+    }
+
+    {
+        // chunks are kept until cleared; reset starts a new stream
+
+        fastcdc<> c;
+
+        c.update( data.data(), 100000 );
+
+        std::size_t k = c.chunks().size();
+        BOOST_TEST_GT( k, 0u );
+
+        c.clear_chunks();
+        BOOST_TEST_EQ( c.chunks().size(), 0u );
+
+        c.update( data.data() + 100000, 100000 );
+        c.finish();
+
+        std::vector<fastcdc<>::chunk> v = chunk_all( fastcdc<>(), data.data(), 200000, 200000 );
+
+        BOOST_TEST_EQ( k + c.chunks().size(), v.size() );
+
+        c.reset();
+
+        BOOST_TEST_EQ( c.size(), 0u );
+        BOOST_TEST_EQ( c.chunks().size(), 0u );
+
+        c.update( data.data(), 200000 );
+        c.finish();
+
+        BOOST_TEST_EQ( c.chunks().size(), v.size() );
+    }
+
+    {
+        // invalid sizes
+
+        BOOST_TEST_THROWS( fastcdc<>( 0, 100, 200 ), std::invalid_argument );
+        BOOST_TEST_THROWS( fastcdc<>( 200, 100, 300 ), std::invalid_argument );
+        BOOST_TEST_THROWS( fastcdc<>( 100, 300, 200 ), std::invalid_argument );
+        BOOST_TEST_THROWS( fastcdc<>( 7, 300, 200, 100 ), std::invalid_argument );
+        BOOST_TEST_THROWS( fastcdc<>( data.data(), 16, 300, 300, 299 ), std::invalid_argument );
+
+        if( sizeof( std::size_t ) >= 8 )
+        {
+            std::size_t const m = static_cast<std::size_t>( -1 );
+
+            BOOST_TEST_THROWS( fastcdc<>( 1, m / 4 + 1, m ), std::invalid_argument );
+            BOOST_TEST_THROWS( fastcdc<>( 1, m, m ), std::invalid_argument );
+
+            fastcdc<>( 1, m / 4, m );
+        }
+    }
+
+    test_digest<sha2_256>();
+    test_digest<xxhash_64>();
+
+    test_shift<sha2_256>();
+    test_shift<xxhash_64>();
+
+    return boost::report_errors();
+}
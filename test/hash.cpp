@@ -0,0 +1,109 @@
+// Copyright 2024 Peter Dimov.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/hash2/hash.hpp>
+#include <boost/hash2/fnv1a.hpp>
+#include <boost/hash2/xxhash.hpp>
+#include <boost/hash2/siphash.hpp>
+#include <boost/hash2/md5.hpp>
+#include <boost/hash2/sha1.hpp>
+#include <boost/hash2/sha2.hpp>
+#include <boost/hash2/ripemd.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/core/lightweight_test_trait.hpp>
+#include <boost/config.hpp>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(BOOST_MSVC) && BOOST_MSVC < 1920
+# pragma warning(disable: 4307) // integral constant overflow
+#endif
+
+unsigned char data[ 300 ];
+
+template<class H> void test( std::uint64_t seed )
+{
+    for( std::size_t n = 0; n <= sizeof(data); ++n )
+    {
+        H h( seed );
+        h.update( data, n );
+
+        typename H::result_type r = h.result();
+
+        BOOST_TEST( boost::hash2::hash<H>( data, n, seed ) == r );
+        BOOST_TEST( boost::hash2::hash<H>( static_cast<void const*>( data ), n, seed ) == r );
+    }
+}
+
+template<class H> void test()
+{
+    test<H>( 0 );
+    test<H>( 7 );
+    test<H>( 0x0102030405060708ull );
+
+    {
+        H h;
+        h.update( data, 45 );
+
+        BOOST_TEST( boost::hash2::hash<H>( data, 45 ) == h.result() );
+    }
+}
+
+#define STATIC_ASSERT(...) static_assert(__VA_ARGS__, #__VA_ARGS__)
+
+#if defined(BOOST_NO_CXX14_CONSTEXPR)
+
+# define TEST_EQ(x1, x2) BOOST_TEST_EQ(x1, x2)
+
+#else
+
+# define TEST_EQ(x1, x2) BOOST_TEST_EQ(x1, x2); STATIC_ASSERT(x1 == x2)
+
+#endif
+
+int main()
+{
+    for( std::size_t i = 0; i < sizeof(data); ++i )
+    {
+        data[ i ] = static_cast<unsigned char>( i * 0x9D + 0x3B );
+    }
+
+    using namespace boost::hash2;
+
+    BOOST_TEST_TRAIT_TRUE((detail::has_one_shot_hash<xxhash_32>));
+    BOOST_TEST_TRAIT_TRUE((detail::has_one_shot_hash<xxhash_64>));
+    BOOST_TEST_TRAIT_FALSE((detail::has_one_shot_hash<siphash_64>));
+    BOOST_TEST_TRAIT_FALSE((detail::has_one_shot_hash<sha2_256>));
+
+    test<fnv1a_32>();
+    test<fnv1a_64>();
+    test<xxhash_32>();
+    test<xxhash_64>();
+    test<siphash_32>();
+    test<siphash_64>();
+    test<md5_128>();
+    test<sha1_160>();
+    test<sha2_256>();
+    test<sha2_512>();
+    test<ripemd_160>();
+
+    {
+        constexpr unsigned char v21[ 21 ] = {};
+        constexpr unsigned char v45[ 45 ] = {};
+
+        TEST_EQ( hash<xxhash_32>( v21, 21 ), 86206869 );
+        TEST_EQ( hash<xxhash_32>( v45, 45 ), 747548280 );
+
+        TEST_EQ( hash<xxhash_64>( v21, 21 ), 8680240691998137788 );
+        TEST_EQ( hash<xxhash_64>( v45, 45 ), 4352694002423811028 );
+
+        TEST_EQ( hash<xxhash_32>( v21, 21, 7 ), 2135174986 );
+        TEST_EQ( hash<xxhash_32>( v45, 45, 7 ), 1547773082 );
+
+        TEST_EQ( hash<xxhash_64>( v21, 21, 7 ), 16168826474312362322ull );
+        TEST_EQ( hash<xxhash_64>( v45, 45, 7 ), 14120916949766558435ull );
+    }
+
+    return boost::report_errors();
+}
@@ -0,0 +1,227 @@
+// Copyright 2024 Peter Dimov.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/hash2/hash_append_node.hpp>
+#include <boost/hash2/hash_append.hpp>
+#include <boost/hash2/fnv1a.hpp>
+#include <boost/hash2/xxhash.hpp>
+#include <boost/hash2/sha2.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+
+// a node of an immutable DAG, whose children can be shared
+
+struct node
+{
+    std::string label;
+    std::vector< std::shared_ptr<node const> > children;
+
+    // counts the traversals of nodes
+    static int calls;
+};
+
+int node::calls = 0;
+
+template<class Hash, class Flavor>
+void tag_invoke( boost::hash2::hash_append_tag const&, Hash& h, Flavor const& f, node const& n )
+{
+    ++node::calls;
+
+    boost::hash2::hash_append( h, f, n.label );
+
+    for( auto const& p: n.children )
+    {
+        boost::hash2::hash_append_node( h, f, *p );
+    }
+
+    boost::hash2::hash_append_size( h, f, n.children.size() );
+}
+
+// each node references the previous one twice, for 2^depth paths
+
+static std::shared_ptr<node const> make_dag( int depth )
+{
+    std::shared_ptr<node const> p = std::make_shared<node const>( node{ "leaf", {} } );
+
+    for( int i = 0; i < depth; ++i )
+    {
+        p = std::make_shared<node const>( node{ "n" + std::to_string( i ), { p, p } } );
+    }
+
+    return p;
+}
+
+template<class H, class Flavor> void test()
+{
+    using boost::hash2::node_digest_cache;
+    using boost::hash2::memoizing_flavor;
+
+    {
+        int const depth = 10;
+
+        std::shared_ptr<node const> root = make_dag( depth );
+
+        // reference, without memoization
+
+        node::calls = 0;
+
+        H h1;
+        hash_append_node( h1, Flavor(), *root );
+
+        BOOST_TEST_EQ( node::calls, ( 2 << depth ) - 1 );
+
+        typename H::result_type const r1 = h1.result();
+
+        // memoizing flavor without a cache doesn't memoize
+
+        node::calls = 0;
+
+        H h2;
+        hash_append_node( h2, memoizing_flavor<H, Flavor>(), *root );
+
+        BOOST_TEST_EQ( node::calls, ( 2 << depth ) - 1 );
+        BOOST_TEST( h2.result() == r1 );
+
+        // with a cache, each node is traversed once
+
+        node_digest_cache<H> cache;
+
+        node::calls = 0;
+
+        H h3;
+        hash_append_node( h3, memoizing_flavor<H, Flavor>( cache ), *root );
+
+        BOOST_TEST_EQ( node::calls, depth + 1 );
+        BOOST_TEST_EQ( cache.size(), static_cast<std::size_t>( depth + 1 ) );
+
+        BOOST_TEST( h3.result() == r1 );
+
+        // a persistent cache is reused by later traversals
+
+        node::calls = 0;
+
+        H h4;
+        hash_append_node( h4, memoizing_flavor<H, Flavor>( cache ), *root );
+
+        BOOST_TEST_EQ( node::calls, 0 );
+        BOOST_TEST( h4.result() == r1 );
+
+        // hash_append of the root itself traverses only the root
+
+        node::calls = 0;
+
+        H h5, h6;
+
+        hash_append( h5, memoizing_flavor<H, Flavor>( cache ), *root );
+        hash_append( h6, Flavor(), *root );
+
+        BOOST_TEST_EQ( node::calls, 1 + ( 2 << depth ) - 1 );
+        BOOST_TEST( h5.result() == h6.result() );
+
+        BOOST_TEST( cache.erase( *root ) );
+        BOOST_TEST( !cache.erase( *root ) );
+        BOOST_TEST( cache.find( *root ) == nullptr );
+        BOOST_TEST( cache.find( *root->children[0] ) != nullptr );
+
+        cache.clear();
+        BOOST_TEST_EQ( cache.size(), 0u );
+    }
+
+    {
+        // a seeded cache computes the digests with its prototype
+
+        int const depth = 6;
+
+        std::shared_ptr<node const> root = make_dag( depth );
+
+        node_digest_cache<H> cache( 7 );
+        node_digest_cache<H> cache2( H( 7 ) );
+
+        unsigned char const key[] = { 1, 2, 3 };
+        node_digest_cache<H> cache3( key, sizeof(key) );
+
+        H h2, h3, h4, h5;
+
+        hash_append_node( h2, memoizing_flavor<H, Flavor>( cache ), *root );
+        hash_append_node( h3, memoizing_flavor<H, Flavor>( cache2 ), *root );
+        hash_append_node( h4, memoizing_flavor<H, Flavor>( cache3 ), *root );
+
+        typename H::result_type const r1 = h2.result();
+
+        BOOST_TEST( h3.result() == r1 );
+        BOOST_TEST( h4.result() != r1 );
+
+        // the stored digest of the leaf is that computed by H( 7 )
+
+        node const* leaf = root.get();
+
+        for( int i = 0; i < depth; ++i )
+        {
+            leaf = leaf->children[ 0 ].get();
+        }
+
+        H h0( 7 );
+        hash_append( h0, Flavor(), *leaf );
+
+        BOOST_TEST( cache.find( *leaf ) != nullptr );
+        BOOST_TEST( *cache.find( *leaf ) == h0.result() );
+
+        hash_append_node( h5, Flavor(), *root );
+        BOOST_TEST( h5.result() != r1 );
+
+        // without a cache, the digests are computed with the prototype
+        // of the flavor, so different seeds give different digests
+
+        H h6, h7, h8;
+
+        hash_append_node( h6, memoizing_flavor<H, Flavor>( 7 ), *root );
+        hash_append_node( h7, memoizing_flavor<H, Flavor>( 8 ), *root );
+        hash_append_node( h8, memoizing_flavor<H, Flavor>( H( 7 ) ), *root );
+
+        typename H::result_type const r6 = h6.result();
+
+        BOOST_TEST( r6 == r1 );
+        BOOST_TEST( h7.result() != r6 );
+        BOOST_TEST( h8.result() == r6 );
+
+        // the digest of a single node depends on the seed
+
+        H h9, h10;
+
+        hash_append_node( h9, memoizing_flavor<H, Flavor>( 7 ), *leaf );
+        hash_append_node( h10, memoizing_flavor<H, Flavor>( key, sizeof(key) ), *leaf );
+
+        BOOST_TEST( h9.result() != h10.result() );
+    }
+
+    {
+        // a depth that is infeasible without memoization
+
+        int const depth = 200;
+
+        std::shared_ptr<node const> root = make_dag( depth );
+
+        node_digest_cache<H> cache;
+
+        node::calls = 0;
+
+        H h;
+        hash_append_node( h, memoizing_flavor<H, Flavor>( cache ), *root );
+
+        BOOST_TEST_EQ( node::calls, depth + 1 );
+    }
+}
+
+int main()
+{
+    using namespace boost::hash2;
+
+    test<fnv1a_64, default_flavor>();
+    test<xxhash_64, little_endian_flavor>();
+    test<sha2_256, big_endian_flavor>();
+
+    return boost::report_errors();
+}
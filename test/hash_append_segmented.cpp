@@ -0,0 +1,272 @@
+// Copyright 2024 Peter Dimov.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/hash2/hash_append.hpp>
+#include <boost/hash2/range_segments.hpp>
+#include <boost/hash2/fnv1a.hpp>
+#include <boost/hash2/xxhash.hpp>
+#include <boost/hash2/sha2.hpp>
+#include <boost/circular_buffer.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/core/lightweight_test_trait.hpp>
+#include <deque>
+#include <list>
+#include <set>
+#include <string>
+#include <vector>
+#include <iterator>
+#include <cstddef>
+#include <cstdint>
+
+// a user container made of fixed-size segments, with a forward iterator,
+// which exposes its segments through range_segments
+
+template<class T> class segmented
+{
+private:
+
+    std::list< std::vector<T> > segments_;
+    std::size_t size_ = 0;
+
+public:
+
+    using value_type = T;
+
+    class const_iterator
+    {
+    private:
+
+        typename std::list< std::vector<T> >::const_iterator it_, last_;
+        std::size_t i_;
+
+    public:
+
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T const*;
+        using reference = T const&;
+
+        const_iterator( typename std::list< std::vector<T> >::const_iterator it, typename std::list< std::vector<T> >::const_iterator last ): it_( it ), last_( last ), i_( 0 )
+        {
+        }
+
+        T const& operator*() const
+        {
+            return (*it_)[ i_ ];
+        }
+
+        const_iterator& operator++()
+        {
+            if( ++i_ == it_->size() )
+            {
+                ++it_;
+                i_ = 0;
+            }
+
+            return *this;
+        }
+
+        const_iterator operator++( int )
+        {
+            const_iterator r( *this );
+            ++*this;
+            return r;
+        }
+
+        bool operator==( const_iterator const& rhs ) const
+        {
+            return it_ == rhs.it_ && i_ == rhs.i_;
+        }
+
+        bool operator!=( const_iterator const& rhs ) const
+        {
+            return !( *this == rhs );
+        }
+    };
+
+    void push_back( T const& v )
+    {
+        if( segments_.empty() || segments_.back().size() == 7 )
+        {
+            segments_.push_back( std::vector<T>() );
+            segments_.back().reserve( 7 );
+        }
+
+        segments_.back().push_back( v );
+        ++size_;
+    }
+
+    const_iterator begin() const
+    {
+        return const_iterator( segments_.begin(), segments_.end() );
+    }
+
+    const_iterator end() const
+    {
+        return const_iterator( segments_.end(), segments_.end() );
+    }
+
+    std::size_t size() const
+    {
+        return size_;
+    }
+
+    std::list< std::vector<T> > const& segments() const
+    {
+        return segments_;
+    }
+};
+
+namespace boost
+{
+namespace hash2
+{
+
+template<class T> struct range_segments< segmented<T> >
+{
+    template<class F> static void for_each( segmented<T> const& r, F&& f )
+    {
+        for( auto const& s: r.segments() )
+        {
+            f( s.data(), s.size() );
+        }
+    }
+};
+
+} // namespace hash2
+} // namespace boost
+
+// counts the calls to update
+
+template<class H> class counting: public H
+{
+public:
+
+    std::size_t calls = 0;
+
+    void update( void const* p, std::size_t n )
+    {
+        ++calls;
+        H::update( p, n );
+    }
+};
+
+template<class H, class Flavor, class R> void test( R const& r )
+{
+    using T = typename R::value_type;
+
+    H h1;
+
+    for( auto it = r.begin(); it != r.end(); ++it )
+    {
+        T const v = *it;
+        hash_append( h1, Flavor(), v );
+    }
+
+    hash_append_size( h1, Flavor(), r.size() );
+
+    typename H::result_type r1 = h1.result();
+
+    {
+        H h2;
+        hash_append( h2, Flavor(), r );
+
+        BOOST_TEST( h2.result() == r1 );
+    }
+
+    {
+        H h2;
+        boost::hash2::hash_append_sized_range( h2, Flavor(), r.begin(), r.end() );
+
+        BOOST_TEST( h2.result() == r1 );
+    }
+}
+
+template<class H, class Flavor, class T> void test()
+{
+    std::deque<T> v1;
+    boost::circular_buffer<T> v2( 300 );
+    segmented<T> v3;
+    std::list<T> v4;
+
+    for( std::size_t i = 0; i < 1000; ++i )
+    {
+        test<H, Flavor>( v1 );
+        test<H, Flavor>( v2 );
+        test<H, Flavor>( v3 );
+        test<H, Flavor>( v4 );
+
+        T const v = static_cast<T>( i * 0x9E3779B9u );
+
+        v1.push_back( v );
+
+        if( i % 3 == 0 ) v1.pop_front();
+
+        v2.push_back( v ); // wraps around after 300 elements
+        v3.push_back( v );
+        v4.push_back( v );
+
+        i += i / 64; // test progressively larger ranges, sparsely
+    }
+}
+
+int main()
+{
+    using namespace boost::hash2;
+
+    BOOST_TEST_TRAIT_TRUE((detail::has_range_segments< std::deque<int> >));
+    BOOST_TEST_TRAIT_TRUE((detail::has_range_segments< boost::circular_buffer<int> >));
+    BOOST_TEST_TRAIT_TRUE((detail::has_range_segments< segmented<int> >));
+    BOOST_TEST_TRAIT_FALSE((detail::has_range_segments< std::list<int> >));
+    BOOST_TEST_TRAIT_FALSE((detail::has_range_segments< std::set<int> >));
+
+    // only ranges of contiguously hashable elements use the segments
+
+    BOOST_TEST_TRAIT_TRUE((detail::is_segmented_range_< std::deque<int>, default_flavor >));
+    BOOST_TEST_TRAIT_FALSE((detail::is_segmented_range_< std::deque<std::string>, default_flavor >));
+    BOOST_TEST_TRAIT_FALSE((detail::is_segmented_range_< std::list<int>, default_flavor >));
+
+    test<fnv1a_32, default_flavor, unsigned char>();
+    test<fnv1a_32, default_flavor, char>();
+    test<fnv1a_64, little_endian_flavor, int>();
+    test<xxhash_64, big_endian_flavor, int>();
+    test<xxhash_64, default_flavor, std::uint64_t>();
+    test<sha2_256, default_flavor, std::uint16_t>();
+
+    // the blocks of std::deque and the two spans of circular_buffer are passed to update as a whole
+
+    {
+        std::deque<std::uint32_t> v( 10000, 5 );
+
+        counting<fnv1a_64> h;
+        hash_append( h, {}, v );
+
+        BOOST_TEST_LT( h.calls, 1000u );
+    }
+
+    {
+        boost::circular_buffer<std::uint32_t> v( 256 );
+
+        for( std::uint32_t i = 0; i < 400; ++i ) v.push_back( i );
+
+        counting<fnv1a_64> h;
+        hash_append( h, {}, v );
+
+        BOOST_TEST_EQ( h.calls, 3u ); // two spans and the size
+    }
+
+    {
+        // a std::list is hashed one element at a time
+
+        std::list<std::uint32_t> v( 100, 5 );
+
+        counting<fnv1a_64> h;
+        hash_append( h, {}, v );
+
+        BOOST_TEST_EQ( h.calls, 101u );
+    }
+
+    return boost::report_errors();
+}
@@ -0,0 +1,89 @@
+// Copyright 2024 Peter Dimov.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/hash2/hash_append_par.hpp>
+#include <boost/hash2/hash_append.hpp>
+#include <boost/hash2/fnv1a.hpp>
+#include <boost/hash2/xxhash.hpp>
+#include <boost/hash2/siphash.hpp>
+#include <boost/hash2/md5.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <unordered_set>
+#include <string>
+#include <vector>
+#include <list>
+
+template<class Hash, class Flavor, class R> void test_range( R const& r )
+{
+    std::size_t const threads[] = { 0, 1, 2, 3, 4, 7, 16 };
+
+    for( std::size_t i = 0; i < sizeof(threads) / sizeof(threads[0]); ++i )
+    {
+        Hash h1( 7 );
+        Hash h2( 7 );
+
+        Flavor f;
+
+        hash_append( h1, f, 'x' );
+        hash_append( h2, f, 'x' );
+
+        boost::hash2::hash_append_unordered_range( h1, f, r.begin(), r.end() );
+        boost::hash2::hash_append_unordered_range_par( h2, f, r.begin(), r.end(), threads[ i ] );
+
+        BOOST_TEST( h1.result() == h2.result() );
+    }
+}
+
+template<class Hash, class Flavor> void test()
+{
+    // ranges of 4096 elements per thread and more are hashed in parallel
+
+    for( int n = 0; n < 20000; n = n * 2 + 1 )
+    {
+        std::unordered_set<int> s;
+        std::vector<std::string> v;
+        std::list<double> l;
+
+        for( int i = 0; i < n; ++i )
+        {
+            s.insert( i * 17 );
+            v.push_back( std::to_string( i ) );
+            l.push_back( i / 3.0 );
+        }
+
+        test_range<Hash, Flavor>( s );
+        test_range<Hash, Flavor>( v );
+        test_range<Hash, Flavor>( l );
+    }
+}
+
+int main()
+{
+    using namespace boost::hash2;
+
+    test<fnv1a_32, default_flavor>();
+    test<fnv1a_64, little_endian_flavor>();
+    test<xxhash_64, big_endian_flavor>();
+    test<siphash_64, default_flavor>();
+    test<md5_128, default_flavor>();
+
+    {
+        std::unordered_set<int> s1, s2;
+
+        for( int i = 0; i < 16384; ++i )
+        {
+            s1.insert( i );
+            s2.insert( 16383 - i );
+        }
+
+        siphash_64 h1, h2;
+
+        hash_append_unordered_range_par( h1, {}, s1.begin(), s1.end(), 4 );
+        hash_append( h2, {}, s2 );
+
+        BOOST_TEST_EQ( h1.result(), h2.result() );
+    }
+
+    return boost::report_errors();
+}
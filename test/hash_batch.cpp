@@ -0,0 +1,112 @@
+// Copyright 2024 Peter Dimov.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/hash2/hash_batch.hpp>
+#include <boost/hash2/hash_append.hpp>
+#include <boost/hash2/get_integral_result.hpp>
+#include <boost/hash2/fnv1a.hpp>
+#include <boost/hash2/xxhash.hpp>
+#include <boost/hash2/siphash.hpp>
+#include <boost/hash2/sha2.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <string>
+#include <vector>
+#include <list>
+#include <iterator>
+#include <cstddef>
+#include <cstdint>
+
+template<class H, class Flavor, class T> void test( std::vector<T> const& v )
+{
+    using R = typename H::result_type;
+
+    H const h0( 0x0102030405060708ull );
+    Flavor f;
+
+    std::vector<R> r1;
+    std::vector<std::size_t> s1;
+
+    for( std::size_t i = 0; i < v.size(); ++i )
+    {
+        H h( h0 );
+        hash_append( h, f, v[ i ] );
+
+        R r = h.result();
+
+        r1.push_back( r );
+        s1.push_back( boost::hash2::get_integral_result<std::size_t>( r ) );
+    }
+
+    {
+        std::vector<R> r2( v.size() );
+
+        auto p = boost::hash2::hash_batch( h0, f, v.begin(), v.end(), r2.begin() );
+
+        BOOST_TEST( p == r2.end() );
+        BOOST_TEST( r1 == r2 );
+    }
+
+    {
+        std::vector<std::size_t> s2( v.size() );
+
+        boost::hash2::hash_batch( h0, f, v.begin(), v.end(), s2.data() );
+
+        BOOST_TEST( s1 == s2 );
+    }
+
+    {
+        std::vector<R> r2;
+
+        std::list<T> l( v.begin(), v.end() );
+        boost::hash2::hash_batch( h0, f, l.begin(), l.end(), std::back_inserter( r2 ) );
+
+        BOOST_TEST( r1 == r2 );
+    }
+}
+
+template<class H> void test_seed( std::vector<std::uint32_t> const& v )
+{
+    std::vector<typename H::result_type> r1, r2;
+
+    for( std::size_t i = 0; i < v.size(); ++i )
+    {
+        H h( 7 );
+        hash_append( h, {}, v[ i ] );
+
+        r1.push_back( h.result() );
+    }
+
+    boost::hash2::hash_batch<H>( 7, v.begin(), v.end(), std::back_inserter( r2 ) );
+
+    BOOST_TEST( r1 == r2 );
+}
+
+int main()
+{
+    using namespace boost::hash2;
+
+    for( std::size_t n = 0; n < 19; ++n )
+    {
+        std::vector<std::uint32_t> v1;
+        std::vector<std::string> v2;
+
+        for( std::size_t i = 0; i < n; ++i )
+        {
+            v1.push_back( static_cast<std::uint32_t>( i * 0x9E3779B9u ) );
+            v2.push_back( std::string( i, 'x' ) + std::to_string( i ) );
+        }
+
+        test<fnv1a_32, default_flavor>( v1 );
+        test<xxhash_32, little_endian_flavor>( v1 );
+        test<xxhash_64, big_endian_flavor>( v1 );
+        test<siphash_64, default_flavor>( v2 );
+        test<sha2_256, default_flavor>( v2 );
+        test<hmac_sha2_256, default_flavor>( v2 );
+
+        test_seed<xxhash_64>( v1 );
+        test_seed<siphash_32>( v1 );
+    }
+
+    return boost::report_errors();
+}
@@ -0,0 +1,84 @@
+// Copyright 2024 Peter Dimov.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/hash2/fnv1a.hpp>
+#include <boost/hash2/xxhash.hpp>
+#include <boost/hash2/siphash.hpp>
+#include <boost/hash2/md5.hpp>
+#include <boost/hash2/sha1.hpp>
+#include <boost/hash2/sha2.hpp>
+#include <boost/hash2/ripemd.hpp>
+#include <boost/hash2/hmac.hpp>
+#include <cstddef>
+#include <cstdint>
+
+using namespace boost::hash2;
+
+// the hash algorithms are copied per element and stored per object,
+// so their size is kept to the running state, the buffer, and the
+// message length; the m_ buffer offset is derived from the length
+
+// n rounded up to the alignment of the std::uint64_t length
+
+constexpr std::size_t padded( std::size_t n )
+{
+    return ( n + alignof( std::uint64_t ) - 1 ) / alignof( std::uint64_t ) * alignof( std::uint64_t );
+}
+
+// state
+
+static_assert( sizeof( fnv1a_32 ) == 4, "fnv1a_32 size" );
+static_assert( sizeof( fnv1a_64 ) == 8, "fnv1a_64 size" );
+
+// state, buffer, length (and the 16 byte flag in xxhash_32)
+
+static_assert( sizeof( xxhash_32 ) == 16 + 16 + 4 + 4, "xxhash_32 size" );
+static_assert( sizeof( xxhash_64 ) == 32 + 32 + 8, "xxhash_64 size" );
+
+static_assert( sizeof( siphash_32 ) == 16 + 4 + 4, "siphash_32 size" );
+static_assert( sizeof( siphash_64 ) == 32 + 8 + 8, "siphash_64 size" );
+
+static_assert( sizeof( md5_128 ) == 16 + 64 + 8, "md5_128 size" );
+static_assert( sizeof( sha1_160 ) == padded( 20 + 64 ) + 8, "sha1_160 size" );
+
+static_assert( sizeof( sha2_256 ) == 32 + 64 + 8, "sha2_256 size" );
+static_assert( sizeof( sha2_224 ) == 32 + 64 + 8, "sha2_224 size" );
+static_assert( sizeof( sha2_512 ) == 64 + 128 + 8, "sha2_512 size" );
+static_assert( sizeof( sha2_384 ) == 64 + 128 + 8, "sha2_384 size" );
+static_assert( sizeof( sha2_512_224 ) == 64 + 128 + 8, "sha2_512_224 size" );
+static_assert( sizeof( sha2_512_256 ) == 64 + 128 + 8, "sha2_512_256 size" );
+
+static_assert( sizeof( ripemd_128 ) == 16 + 64 + 8, "ripemd_128 size" );
+static_assert( sizeof( ripemd_160 ) == padded( 20 + 64 ) + 8, "ripemd_160 size" );
+
+// hmac holds the inner and the outer hash, and nothing else
+
+static_assert( sizeof( hmac_md5_128 ) == 2 * sizeof( md5_128 ), "hmac_md5_128 size" );
+static_assert( sizeof( hmac_sha1_160 ) == 2 * sizeof( sha1_160 ), "hmac_sha1_160 size" );
+static_assert( sizeof( hmac_sha2_256 ) == 2 * sizeof( sha2_256 ), "hmac_sha2_256 size" );
+static_assert( sizeof( hmac_sha2_512 ) == 2 * sizeof( sha2_512 ), "hmac_sha2_512 size" );
+
+// each is one std::size_t smaller than before m_ was removed; the
+// figures are those of x86-64, where std::size_t is 8 bytes
+
+static_assert( sizeof( std::size_t ) != 8 || sizeof( xxhash_32 ) == 48 - 8, "xxhash_32 size" );
+static_assert( sizeof( std::size_t ) != 8 || sizeof( xxhash_64 ) == 80 - 8, "xxhash_64 size" );
+static_assert( sizeof( std::size_t ) != 8 || sizeof( siphash_64 ) == 56 - 8, "siphash_64 size" );
+static_assert( sizeof( std::size_t ) != 8 || sizeof( md5_128 ) == 96 - 8, "md5_128 size" );
+static_assert( sizeof( std::size_t ) != 8 || sizeof( sha1_160 ) == 104 - 8, "sha1_160 size" );
+static_assert( sizeof( std::size_t ) != 8 || sizeof( sha2_256 ) == 112 - 8, "sha2_256 size" );
+static_assert( sizeof( std::size_t ) != 8 || sizeof( sha2_512 ) == 208 - 8, "sha2_512 size" );
+static_assert( sizeof( std::size_t ) != 8 || sizeof( ripemd_160 ) == 104 - 8, "ripemd_160 size" );
+static_assert( sizeof( std::size_t ) != 8 || sizeof( hmac_sha2_256 ) == 224 - 16, "hmac_sha2_256 size" );
+
+// the alignment never exceeds that of std::uint64_t
+
+static_assert( alignof( xxhash_32 ) == alignof( std::uint32_t ), "xxhash_32 alignment" );
+static_assert( alignof( xxhash_64 ) <= alignof( std::uint64_t ), "xxhash_64 alignment" );
+static_assert( alignof( siphash_32 ) == alignof( std::uint32_t ), "siphash_32 alignment" );
+static_assert( alignof( sha2_512 ) <= alignof( std::uint64_t ), "sha2_512 alignment" );
+
+int main()
+{
+}
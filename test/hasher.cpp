@@ -0,0 +1,161 @@
+// Copyright 2024 Peter Dimov.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/hash2/hasher.hpp>
+#include <boost/hash2/hash_append.hpp>
+#include <boost/hash2/get_integral_result.hpp>
+#include <boost/hash2/fnv1a.hpp>
+#include <boost/hash2/xxhash.hpp>
+#include <boost/hash2/siphash.hpp>
+#include <boost/hash2/md5.hpp>
+#include <boost/hash2/sha2.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/core/lightweight_test_trait.hpp>
+#include <unordered_set>
+#include <string>
+#include <vector>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// a non-owning view over an int sequence
+
+struct int_span
+{
+    using value_type = int;
+    using const_iterator = int const*;
+
+    int const* p_;
+    std::size_t n_;
+
+    int const* data() const { return p_; }
+    std::size_t size() const { return n_; }
+
+    int const* begin() const { return p_; }
+    int const* end() const { return p_ + n_; }
+};
+
+template<class T, class = void> struct has_is_transparent: std::false_type
+{
+};
+
+template<class T> struct has_is_transparent<T, decltype( (void)sizeof( typename T::is_transparent* ) )>: std::true_type
+{
+};
+
+template<class H, class Flavor, class T> std::size_t reference( H h, T const& v )
+{
+    hash_append( h, Flavor(), v );
+    return boost::hash2::get_integral_result<std::size_t>( h.result() );
+}
+
+template<class H, class Flavor = boost::hash2::default_flavor> void test()
+{
+    using boost::hash2::hasher;
+
+    std::string const s1( "foo" );
+    std::string const s2( 200, 'x' );
+
+    {
+        hasher<std::string, H, Flavor> hf;
+
+        BOOST_TEST_EQ( hf( s1 ), (reference<H, Flavor>( H(), s1 )) );
+        BOOST_TEST_EQ( hf( s2 ), (reference<H, Flavor>( H(), s2 )) );
+    }
+
+    {
+        hasher<std::string, H, Flavor> hf( 0x0102030405060708ull );
+
+        BOOST_TEST_EQ( hf( s1 ), (reference<H, Flavor>( H( 0x0102030405060708ull ), s1 )) );
+        BOOST_TEST_EQ( hf( s2 ), (reference<H, Flavor>( H( 0x0102030405060708ull ), s2 )) );
+    }
+
+    {
+        unsigned char const seed[] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17 };
+
+        for( std::size_t n = 0; n <= sizeof(seed); ++n )
+        {
+            hasher<std::string, H, Flavor> hf( seed, n );
+            hasher<std::string, H, Flavor> const hf2( hf );
+
+            BOOST_TEST_EQ( hf( s1 ), (reference<H, Flavor>( H( seed, n ), s1 )) );
+            BOOST_TEST_EQ( hf2( s2 ), (reference<H, Flavor>( H( seed, n ), s2 )) );
+
+            // the prototype is not modified by operator()
+            BOOST_TEST_EQ( hf( s1 ), hf( s1 ) );
+        }
+    }
+
+    {
+        hasher<std::uint32_t, H, Flavor> hf( 7 );
+
+        for( std::uint32_t i = 0; i < 64; ++i )
+        {
+            BOOST_TEST_EQ( hf( i ), (reference<H, Flavor>( H( 7 ), i )) );
+        }
+    }
+
+    {
+        std::vector<int> v;
+
+        for( int i = 0; i < 37; ++i )
+        {
+            v.push_back( i * i );
+
+            int_span sp = { v.data(), v.size() };
+
+            hasher< std::vector<int>, H, Flavor > hf( 3 );
+            BOOST_TEST_EQ( hf( sp ), hf( v ) );
+        }
+    }
+}
+
+int main()
+{
+    using namespace boost::hash2;
+
+    BOOST_TEST_TRAIT_TRUE((hasher<std::string, fnv1a_64>::is_avalanching));
+    BOOST_TEST_TRAIT_TRUE((std::is_same<hasher<std::string, md5_128>::hash_type, md5_128>));
+    BOOST_TEST_TRAIT_TRUE((std::is_same<hasher<std::string, md5_128>::flavor_type, default_flavor>));
+
+    BOOST_TEST_TRAIT_TRUE((has_is_transparent< hasher<std::string, fnv1a_64> >));
+    BOOST_TEST_TRAIT_TRUE((has_is_transparent< hasher<std::vector<int>, fnv1a_64> >));
+    BOOST_TEST_TRAIT_FALSE((has_is_transparent< hasher<int, fnv1a_64> >));
+    BOOST_TEST_TRAIT_FALSE((has_is_transparent< hasher<std::array<int, 4>, fnv1a_64> >));
+
+    BOOST_TEST_TRAIT_TRUE((is_hash_compatible<std::vector<int>, int_span>));
+    BOOST_TEST_TRAIT_FALSE((is_hash_compatible<std::vector<int>, std::vector<long long>>));
+    BOOST_TEST_TRAIT_FALSE((is_hash_compatible<std::vector<int>, std::array<int, 4>>));
+
+    BOOST_TEST_TRAIT_TRUE((std::is_same<select_hash_t<fnv1a_32, fnv1a_64>, std::conditional<sizeof(std::size_t) == 4, fnv1a_32, fnv1a_64>::type>));
+    BOOST_TEST_TRAIT_TRUE((std::is_same<select_hash_t<md5_128>, md5_128>));
+
+    test<fnv1a_32>();
+    test<fnv1a_64>();
+    test<xxhash_32>();
+    test<xxhash_64>();
+    test<siphash_32>();
+    test<siphash_64>();
+    test<md5_128>();
+    test<sha2_256>();
+    test<hmac_sha2_256>();
+    test<xxhash_64, little_endian_flavor>();
+    test<xxhash_64, big_endian_flavor>();
+
+    {
+        using H = select_hash_t<siphash_32, siphash_64>;
+
+        std::unordered_set< std::string, hasher<std::string, H> > st( 0, hasher<std::string, H>( 42 ) );
+
+        st.insert( "foo" );
+        st.insert( "bar" );
+        st.insert( "foo" );
+
+        BOOST_TEST_EQ( st.size(), 2u );
+        BOOST_TEST_EQ( st.count( "bar" ), 1u );
+        BOOST_TEST_EQ( st.count( "baz" ), 0u );
+    }
+
+    return boost::report_errors();
+}
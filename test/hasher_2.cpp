@@ -0,0 +1,115 @@
+// Copyright 2024 Peter Dimov.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/hash2/hasher.hpp>
+#include <boost/hash2/fnv1a.hpp>
+#include <boost/hash2/xxhash.hpp>
+#include <boost/hash2/siphash.hpp>
+#include <boost/hash2/sha2.hpp>
+#include <boost/utility/string_view.hpp>
+#include <boost/core/detail/string_view.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/core/lightweight_test_trait.hpp>
+#include <boost/config.hpp>
+#include <string>
+#include <vector>
+#include <cstddef>
+#if !defined(BOOST_NO_CXX17_HDR_STRING_VIEW)
+#include <string_view>
+#endif
+
+using boost::hash2::is_hash_compatible;
+
+// compile-time guarantee that the lookup key types hash identically to std::string
+
+static_assert( is_hash_compatible<std::string, std::string>::value, "" );
+static_assert( is_hash_compatible<std::string, char const*>::value, "" );
+static_assert( is_hash_compatible<std::string, char*>::value, "" );
+static_assert( is_hash_compatible<std::string, char const[4]>::value, "" );
+static_assert( is_hash_compatible<std::string, boost::string_view>::value, "" );
+static_assert( is_hash_compatible<std::string, boost::core::string_view>::value, "" );
+static_assert( is_hash_compatible<std::wstring, wchar_t const*>::value, "" );
+static_assert( is_hash_compatible<std::u16string, char16_t const*>::value, "" );
+static_assert( is_hash_compatible<std::u32string, char32_t const*>::value, "" );
+static_assert( is_hash_compatible<std::vector<char>, std::string>::value, "" );
+
+#if !defined(BOOST_NO_CXX17_HDR_STRING_VIEW)
+
+static_assert( is_hash_compatible<std::string, std::string_view>::value, "" );
+static_assert( is_hash_compatible<std::wstring, std::wstring_view>::value, "" );
+
+#endif
+
+static_assert( !is_hash_compatible<std::string, std::wstring>::value, "" );
+static_assert( !is_hash_compatible<std::string, wchar_t const*>::value, "" );
+static_assert( !is_hash_compatible<std::string, int const*>::value, "" );
+static_assert( !is_hash_compatible<std::vector<int>, int const*>::value, "" );
+static_assert( !is_hash_compatible<int, long>::value, "" );
+
+template<class H, class Ch> void test( Ch const* s )
+{
+    using boost::hash2::hasher;
+
+    std::basic_string<Ch> const str( s );
+    std::vector<Ch> v( str.begin(), str.end() );
+
+    {
+        hasher<std::basic_string<Ch>, H> hf( 0x0102030405060708ull );
+
+        std::size_t r = hf( str );
+
+        BOOST_TEST_EQ( hf( s ), r );
+        BOOST_TEST_EQ( hf( const_cast<Ch*>( s ) ), r );
+        BOOST_TEST_EQ( hf( v ), r );
+        BOOST_TEST_EQ( hf( boost::basic_string_view<Ch>( s ) ), r );
+        BOOST_TEST_EQ( hf( boost::core::basic_string_view<Ch>( s ) ), r );
+
+#if !defined(BOOST_NO_CXX17_HDR_STRING_VIEW)
+
+        BOOST_TEST_EQ( hf( std::basic_string_view<Ch>( s ) ), r );
+
+#endif
+    }
+
+    {
+        hasher<std::basic_string<Ch>, H, boost::hash2::big_endian_flavor> hf;
+
+        std::size_t r = hf( str );
+
+        BOOST_TEST_EQ( hf( s ), r );
+        BOOST_TEST_EQ( hf( v ), r );
+        BOOST_TEST_EQ( hf( boost::core::basic_string_view<Ch>( s ) ), r );
+    }
+}
+
+template<class H> void test()
+{
+    test<H>( "" );
+    test<H>( "foo" );
+    test<H>( "content-type" );
+    test<H>( "a somewhat longer string that spans more than one block of the hash algorithm" );
+
+    test<H>( L"foo" );
+    test<H>( u"foo" );
+    test<H>( U"foo" );
+
+    {
+        boost::hash2::hasher<std::string, H> hf( 7 );
+
+        // string literals are hashed up to the terminating null, as std::string would
+        BOOST_TEST_EQ( hf( "foo" ), hf( std::string( "foo" ) ) );
+    }
+}
+
+int main()
+{
+    using namespace boost::hash2;
+
+    test<fnv1a_64>();
+    test<xxhash_64>();
+    test<siphash_64>();
+    test<sha2_256>();
+
+    return boost::report_errors();
+}
@@ -0,0 +1,188 @@
+// Copyright 2024 Peter Dimov.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/hash2/hkdf.hpp>
+#include <boost/hash2/sha1.hpp>
+#include <boost/hash2/sha2.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <cstddef>
+
+std::string from_hex( char const* s )
+{
+    std::string r;
+
+    for( ; s[ 0 ] && s[ 1 ]; s += 2 )
+    {
+        auto d = []( char c ){ return c <= '9'? c - '0': c - 'a' + 10; };
+        r += static_cast<char>( d( s[ 0 ] ) * 16 + d( s[ 1 ] ) );
+    }
+
+    return r;
+}
+
+std::string to_hex( unsigned char const* p, std::size_t n )
+{
+    char const* hex = "0123456789abcdef";
+
+    std::string r;
+
+    for( std::size_t i = 0; i < n; ++i )
+    {
+        r += hex[ p[ i ] >> 4 ];
+        r += hex[ p[ i ] & 0xF ];
+    }
+
+    return r;
+}
+
+unsigned char const* bytes( std::string const& s )
+{
+    return reinterpret_cast<unsigned char const*>( s.data() );
+}
+
+template<class H> void test( std::string const& ikm, std::string const& salt, std::string const& info, std::size_t n, char const* prk, char const* okm )
+{
+    using hkdf = boost::hash2::hkdf<H>;
+
+    typename hkdf::result_type r = hkdf::extract( bytes( salt ), salt.size(), bytes( ikm ), ikm.size() );
+
+    BOOST_TEST_EQ( to_string( r ), std::string( prk ) );
+
+    {
+        std::vector<unsigned char> v( n );
+        hkdf::expand( r, bytes( info ), info.size(), v.data(), v.size() );
+
+        BOOST_TEST_EQ( to_hex( v.data(), v.size() ), std::string( okm ) );
+    }
+
+    {
+        std::vector<unsigned char> v( n );
+        hkdf::expand( r.data(), r.size(), bytes( info ), info.size(), v.data(), v.size() );
+
+        BOOST_TEST_EQ( to_hex( v.data(), v.size() ), std::string( okm ) );
+    }
+
+    {
+        std::vector<unsigned char> v( n );
+        hkdf::derive( bytes( salt ), salt.size(), bytes( ikm ), ikm.size(), bytes( info ), info.size(), v.data(), v.size() );
+
+        BOOST_TEST_EQ( to_hex( v.data(), v.size() ), std::string( okm ) );
+    }
+
+    // shorter outputs are prefixes
+
+    for( std::size_t m = 0; m <= n; ++m )
+    {
+        std::vector<unsigned char> v( m );
+        hkdf::expand( r, bytes( info ), info.size(), v.data(), v.size() );
+
+        BOOST_TEST_EQ( to_hex( v.data(), v.size() ), std::string( okm ).substr( 0, 2 * m ) );
+    }
+}
+
+using boost::hash2::sha1_160;
+using boost::hash2::sha2_256;
+
+int main()
+{
+    // Test vectors from https://www.rfc-editor.org/rfc/rfc5869#appendix-A
+
+    test<sha2_256>(
+        std::string( 22, 0x0b ),
+        from_hex( "000102030405060708090a0b0c" ),
+        from_hex( "f0f1f2f3f4f5f6f7f8f9" ),
+        42,
+        "077709362c2e32df0ddc3f0dc47bba6390b6c73bb50f9c3122ec844ad7c2b3e5",
+        "3cb25f25faacd57a90434f64d0362f2a2d2d0a90cf1a5a4c5db02d56ecc4c5bf34007208d5b887185865" );
+
+    {
+        std::string ikm, salt, info;
+
+        for( int i = 0; i < 80; ++i )
+        {
+            ikm += static_cast<char>( i );
+            salt += static_cast<char>( 0x60 + i );
+            info += static_cast<char>( 0xb0 + i );
+        }
+
+        test<sha2_256>(
+            ikm, salt, info,
+            82,
+            "06a6b88c5853361a06104c9ceb35b45cef760014904671014a193f40c15fc244",
+            "b11e398dc80327a1c8e7f78c596a49344f012eda2d4efad8a050cc4c19afa97c59045a99cac7827271cb41c65e590e09da3275600c2f09b8367793a9aca3db71cc30c58179ec3e87c14c01d5c1f3434f1d87" );
+    }
+
+    test<sha2_256>(
+        std::string( 22, 0x0b ),
+        std::string(),
+        std::string(),
+        42,
+        "19ef24a32c717b167f33a91d6f648bdf96596776afdb6377ac434c1c293ccb04",
+        "8da4e775a563c18f715f802a063c5a31b8a11f5c5ee1879ec3454e5f3c738d2d9d201395faa4b61a96c8" );
+
+    test<sha1_160>(
+        std::string( 11, 0x0b ),
+        from_hex( "000102030405060708090a0b0c" ),
+        from_hex( "f0f1f2f3f4f5f6f7f8f9" ),
+        42,
+        "9b6c18c432a7bf8f0e71c8eb88f4b30baa2ba243",
+        "085a01ea1b10f36933068b56efa5ad81a4f14b822f5b091568a9cdd4f155fda2c22e422478d305f3f896" );
+
+    test<sha1_160>(
+        std::string( 22, 0x0b ),
+        std::string(),
+        std::string(),
+        42,
+        "da8c8a73c7fa77288ec6f5e7c297786aa0d32d01",
+        "0ac1af7002b3d761d1e55298da9d0506b9ae52057220a306e07b6b87e8df21d0ea00033de03984d34918" );
+
+    // salt not provided, equivalent to HashLen zero bytes
+
+    test<sha1_160>(
+        std::string( 22, 0x0c ),
+        std::string(),
+        std::string(),
+        42,
+        "2adccada18779e7c2077ad2eb19d3f3e731385dd",
+        "2c91117204d745f3500d636a62f64f0ab3bae548aa53d423b0d1f27ebba6f5e5673a081d70cce7acfc48" );
+
+    test<sha1_160>(
+        std::string( 22, 0x0c ),
+        std::string( 20, 0 ),
+        std::string(),
+        42,
+        "2adccada18779e7c2077ad2eb19d3f3e731385dd",
+        "2c91117204d745f3500d636a62f64f0ab3bae548aa53d423b0d1f27ebba6f5e5673a081d70cce7acfc48" );
+
+    // maximum output length
+
+    {
+        using hkdf = boost::hash2::hkdf<sha2_256>;
+
+        BOOST_TEST_EQ( hkdf::hash_size, 32u );
+        BOOST_TEST_EQ( hkdf::max_size, 255u * 32 );
+
+        std::vector<unsigned char> v( hkdf::max_size );
+        hkdf::expand( hkdf::extract( nullptr, 0, nullptr, 0 ), nullptr, 0, v.data(), v.size() );
+
+        std::vector<unsigned char> w( 100 );
+        hkdf::expand( hkdf::extract( nullptr, 0, nullptr, 0 ), nullptr, 0, w.data(), w.size() );
+
+        BOOST_TEST( std::vector<unsigned char>( v.begin(), v.begin() + 100 ) == w );
+
+        // one byte more is rejected, and nothing is written
+
+        std::vector<unsigned char> u( hkdf::max_size + 1 );
+
+        BOOST_TEST_THROWS( hkdf::expand( hkdf::extract( nullptr, 0, nullptr, 0 ), nullptr, 0, u.data(), u.size() ), std::length_error );
+        BOOST_TEST_THROWS( hkdf::derive( nullptr, 0, nullptr, 0, nullptr, 0, u.data(), u.size() ), std::length_error );
+
+        BOOST_TEST( u == std::vector<unsigned char>( hkdf::max_size + 1 ) );
+    }
+
+    return boost::report_errors();
+}
@@ -0,0 +1,114 @@
+// Copyright 2024 Peter Dimov.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/hash2/hmac_batch.hpp>
+#include <boost/hash2/sha1.hpp>
+#include <boost/hash2/sha2.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <string>
+#include <vector>
+#include <list>
+#include <iterator>
+#include <cstddef>
+
+template<class H> void test( std::size_t n )
+{
+    using boost::hash2::hmac;
+    using boost::hash2::hmac_key;
+
+    using R = typename hmac<H>::result_type;
+
+    std::vector< hmac_key<H> > keys;
+    std::vector< std::string > secrets;
+    std::vector< std::string > msgs;
+    std::vector< R > r1;
+
+    for( std::size_t i = 0; i < n; ++i )
+    {
+        std::string secret( i % 3 * 40, static_cast<char>( 'k' + i % 3 ) );
+        std::string msg( i * 11, static_cast<char>( 'a' + i % 26 ) );
+
+        secrets.push_back( secret );
+        keys.push_back( hmac_key<H>( reinterpret_cast<unsigned char const*>( secret.data() ), secret.size() ) );
+        msgs.push_back( msg );
+
+        hmac<H> h( reinterpret_cast<unsigned char const*>( secret.data() ), secret.size() );
+        h.update( msg.data(), msg.size() );
+
+        r1.push_back( h.result() );
+    }
+
+    {
+        std::vector<R> r2( n );
+
+        auto p = boost::hash2::hmac_sign_batch<H>( keys.begin(), msgs.begin(), msgs.end(), r2.begin() );
+
+        BOOST_TEST( p == r2.end() );
+        BOOST_TEST( r1 == r2 );
+    }
+
+    {
+        std::list<std::string> l( msgs.begin(), msgs.end() );
+        std::vector<R> r2;
+
+        boost::hash2::hmac_sign_batch<H>( keys.begin(), l.begin(), l.end(), std::back_inserter( r2 ) );
+
+        BOOST_TEST( r1 == r2 );
+    }
+
+    {
+        std::vector<bool> v;
+
+        boost::hash2::hmac_verify_batch<H>( keys.begin(), msgs.begin(), msgs.end(), r1.begin(), std::back_inserter( v ) );
+
+        BOOST_TEST_EQ( v.size(), n );
+
+        for( std::size_t i = 0; i < v.size(); ++i )
+        {
+            BOOST_TEST( v[ i ] );
+        }
+    }
+
+    {
+        std::vector<R> r3( r1 );
+        std::vector<std::string> r4;
+
+        for( std::size_t i = 0; i < n; ++i )
+        {
+            if( i % 2 == 1 )
+            {
+                r3[ i ].data()[ i % r3[ i ].size() ] ^= 0x01;
+            }
+
+            // truncated MACs don't match
+
+            r4.push_back( std::string( reinterpret_cast<char const*>( r1[ i ].data() ), r1[ i ].size() - i % 2 ) );
+        }
+
+        std::vector<bool> v3, v4;
+
+        boost::hash2::hmac_verify_batch<H>( keys.begin(), msgs.begin(), msgs.end(), r3.begin(), std::back_inserter( v3 ) );
+        boost::hash2::hmac_verify_batch<H>( keys.begin(), msgs.begin(), msgs.end(), r4.begin(), std::back_inserter( v4 ) );
+
+        for( std::size_t i = 0; i < n; ++i )
+        {
+            BOOST_TEST_EQ( v3[ i ], i % 2 == 0 );
+            BOOST_TEST_EQ( v4[ i ], i % 2 == 0 );
+        }
+    }
+}
+
+int main()
+{
+    using namespace boost::hash2;
+
+    for( std::size_t n = 0; n < 11; ++n )
+    {
+        test<sha2_256>( n );
+        test<sha2_512>( n );
+        test<sha1_160>( n );
+    }
+
+    return boost::report_errors();
+}
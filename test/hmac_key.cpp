@@ -0,0 +1,104 @@
+// Copyright 2024 Peter Dimov.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/hash2/hmac.hpp>
+#include <boost/hash2/md5.hpp>
+#include <boost/hash2/sha1.hpp>
+#include <boost/hash2/sha2.hpp>
+#include <boost/hash2/ripemd.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/core/lightweight_test_trait.hpp>
+#include <cstddef>
+#include <cstdint>
+
+unsigned char data[ 300 ];
+
+template<class H> void test()
+{
+    using boost::hash2::hmac;
+    using boost::hash2::hmac_key;
+
+    std::size_t const key_sizes[] = { 0, 1, 20, 63, 64, 65, 128, 129, 200 };
+
+    for( std::size_t i = 0; i < sizeof(key_sizes) / sizeof(key_sizes[0]); ++i )
+    {
+        std::size_t n = key_sizes[ i ];
+
+        hmac_key<H> const key( data + 7, n );
+
+        for( std::size_t m = 0; m < 200; m += 37 )
+        {
+            hmac<H> h1( data + 7, n );
+            h1.update( data, m );
+
+            typename H::result_type const r1 = h1.result();
+
+            hmac<H> h2( key );
+            h2.update( data, m );
+
+            BOOST_TEST( h2.result() == r1 );
+
+            // a key can be reused
+
+            hmac<H> h3( key );
+            h3.update( data, m );
+
+            BOOST_TEST( h3.result() == r1 );
+        }
+    }
+
+    {
+        hmac<H> h1;
+        hmac<H> h2( hmac_key<H>{} );
+
+        BOOST_TEST( h1.result() == h2.result() );
+    }
+
+    {
+        hmac<H> h1( 0x0102030405060708ull );
+        hmac<H> h2( hmac_key<H>( 0x0102030405060708ull ) );
+
+        BOOST_TEST( h1.result() == h2.result() );
+    }
+}
+
+int main()
+{
+    for( std::size_t i = 0; i < sizeof(data); ++i )
+    {
+        data[ i ] = static_cast<unsigned char>( i * 0x9D + 0x3B );
+    }
+
+    using namespace boost::hash2;
+
+    test<md5_128>();
+    test<sha1_160>();
+    test<sha2_256>();
+    test<sha2_224>();
+    test<sha2_512>();
+    test<sha2_384>();
+    test<sha2_512_224>();
+    test<sha2_512_256>();
+    test<ripemd_128>();
+    test<ripemd_160>();
+
+    // algorithms without state export keep full copies
+
+    test<hmac_sha2_256>();
+
+    BOOST_TEST_TRAIT_TRUE((detail::has_state_export<sha2_256>));
+    BOOST_TEST_TRAIT_FALSE((detail::has_state_export<hmac_sha2_256>));
+
+    // only the chaining values are stored
+
+    BOOST_TEST_LE( sizeof( hmac_key<sha2_256> ), 2 * 32 + 1 );
+    BOOST_TEST_LE( sizeof( hmac_key<sha2_512> ), 2 * 64 + 1 );
+    BOOST_TEST_LE( sizeof( hmac_key<md5_128> ), 2 * 16 + 1 );
+
+    // versus two full hash objects in hmac
+
+    BOOST_TEST_EQ( sizeof( hmac_sha2_256 ), 2 * sizeof( sha2_256 ) );
+
+    return boost::report_errors();
+}
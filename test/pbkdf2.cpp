@@ -0,0 +1,82 @@
+// Copyright 2024 Peter Dimov.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/hash2/pbkdf2.hpp>
+#include <boost/hash2/sha1.hpp>
+#include <boost/hash2/sha2.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <cstddef>
+
+template<class H> std::string pbkdf2( std::string const& p, std::string const& s, std::size_t c, std::size_t n, std::size_t threads = 1 )
+{
+    std::vector<unsigned char> v( n );
+
+    boost::hash2::pbkdf2<H>(
+        reinterpret_cast<unsigned char const*>( p.data() ), p.size(),
+        reinterpret_cast<unsigned char const*>( s.data() ), s.size(),
+        c, v.data(), v.size(), threads );
+
+    char const* hex = "0123456789abcdef";
+
+    std::string r;
+
+    for( std::size_t i = 0; i < n; ++i )
+    {
+        r += hex[ v[ i ] >> 4 ];
+        r += hex[ v[ i ] & 0xF ];
+    }
+
+    return r;
+}
+
+using boost::hash2::sha1_160;
+using boost::hash2::sha2_256;
+using boost::hash2::sha2_512;
+
+int main()
+{
+    // Test vectors from https://www.rfc-editor.org/rfc/rfc6070
+    // (the one with 16777216 iterations is omitted for time)
+
+    BOOST_TEST_EQ( pbkdf2<sha1_160>( "password", "salt", 1, 20 ), std::string( "0c60c80f961f0e71f3a9b524af6012062fe037a6" ) );
+    BOOST_TEST_EQ( pbkdf2<sha1_160>( "password", "salt", 2, 20 ), std::string( "ea6c014dc72d6f8ccd1ed92ace1d41f0d8de8957" ) );
+    BOOST_TEST_EQ( pbkdf2<sha1_160>( "password", "salt", 4096, 20 ), std::string( "4b007901b765489abead49d926f721d065a429c1" ) );
+    BOOST_TEST_EQ( pbkdf2<sha1_160>( "passwordPASSWORDpassword", "saltSALTsaltSALTsaltSALTsaltSALTsalt", 4096, 25 ), std::string( "3d2eec4fe41c849b80c8d83662c0e44a8b291a964cf2f07038" ) );
+    BOOST_TEST_EQ( pbkdf2<sha1_160>( std::string( "pass\0word", 9 ), std::string( "sa\0lt", 5 ), 4096, 16 ), std::string( "56fa6aa75548099dcc37d7f03425e0c3" ) );
+
+    // Test vectors from https://www.rfc-editor.org/rfc/rfc7914#section-11
+
+    BOOST_TEST_EQ( pbkdf2<sha2_256>( "passwd", "salt", 1, 64 ), std::string( "55ac046e56e3089fec1691c22544b605f94185216dde0465e68b9d57c20dacbc49ca9cccf179b645991664b39d77ef317c71b845b1e30bd509112041d3a19783" ) );
+    BOOST_TEST_EQ( pbkdf2<sha2_256>( "Password", "NaCl", 80000, 64 ), std::string( "4ddcd8f60b98be21830cee5ef22701f9641a4418d04c0414aeff08876b34ab56a1d425a1225833549adb841b51c9b3176a272bdebba1d078478f62b397f33c8d" ) );
+
+    // output blocks computed in parallel
+
+    for( std::size_t n = 1; n < 200; n += 17 )
+    {
+        std::string r = pbkdf2<sha2_256>( "password", "salt", 100, n );
+
+        BOOST_TEST_EQ( pbkdf2<sha2_256>( "password", "salt", 100, n, 3 ), r );
+        BOOST_TEST_EQ( pbkdf2<sha2_256>( "password", "salt", 100, n, 0 ), r );
+
+        // a shorter output is a prefix of a longer one
+
+        BOOST_TEST_EQ( pbkdf2<sha2_256>( "password", "salt", 100, n + 40, 4 ).substr( 0, 2 * n ), r );
+    }
+
+    BOOST_TEST_EQ( pbkdf2<sha2_512>( "password", "", 10, 150, 2 ), pbkdf2<sha2_512>( "password", "", 10, 150 ) );
+
+    // an iteration count of 0 is rejected, and nothing is written
+
+    {
+        unsigned char out[ 32 ] = { 0xAA };
+
+        BOOST_TEST_THROWS( boost::hash2::pbkdf2<sha2_256>( nullptr, 0, nullptr, 0, 0, out, sizeof( out ) ), std::invalid_argument );
+        BOOST_TEST_EQ( out[ 0 ], 0xAA );
+    }
+
+    return boost::report_errors();
+}
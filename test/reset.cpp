@@ -0,0 +1,249 @@
+// Copyright 2024 Peter Dimov.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/hash2/resettable.hpp>
+#include <boost/hash2/fnv1a.hpp>
+#include <boost/hash2/xxhash.hpp>
+#include <boost/hash2/siphash.hpp>
+#include <boost/hash2/md5.hpp>
+#include <boost/hash2/sha1.hpp>
+#include <boost/hash2/sha2.hpp>
+#include <boost/hash2/ripemd.hpp>
+#include <boost/hash2/hmac.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <stdexcept>
+#include <cstddef>
+#include <cstdint>
+
+unsigned char data[ 300 ];
+
+// h starts out in the same state as h0
+
+template<class H> void test_reset( H& h, H const& h0 )
+{
+    std::size_t const sizes[] = { 0, 1, 7, 31, 63, 64, 65, 127, 200 };
+
+    for( std::size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i )
+    {
+        std::size_t m = sizes[ i ];
+
+        H h2( h0 );
+        h2.update( data, m );
+
+        typename H::result_type r0 = h2.result();
+
+        // dirty the object, leaving a partial block in the buffer
+        h.update( data + 100, 77 );
+        h.result();
+        h.update( data + 1, 5 );
+
+        h.reset();
+
+        h.update( data, m );
+
+        typename H::result_type r1 = h.result();
+
+        BOOST_TEST( r0 == r1 );
+
+        h.reset();
+    }
+}
+
+// reseed gives the same state as construction
+
+template<class H> void test_reseed( H& h, H h0 )
+{
+    std::size_t const sizes[] = { 0, 1, 63, 64, 65, 200 };
+
+    for( std::size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i )
+    {
+        std::size_t m = sizes[ i ];
+
+        H h1( h0 );
+        h1.update( data, m );
+
+        H h2( h );
+        h2.update( data, m );
+
+        BOOST_TEST( h1.result() == h2.result() );
+    }
+}
+
+template<class H> void test()
+{
+    using R = boost::hash2::resettable<H>;
+
+    {
+        R h, h0;
+        test_reset( h, h0 );
+    }
+
+    std::uint64_t const seeds[] = { 0, 1, 0x7F, 0x0102030405060708ull, 0xFFFFFFFF00000000ull };
+
+    for( std::size_t i = 0; i < sizeof(seeds) / sizeof(seeds[0]); ++i )
+    {
+        R h0( seeds[ i ] );
+
+        {
+            R h( seeds[ i ] );
+            test_reset( h, h0 );
+        }
+
+        {
+            H h1( seeds[ i ] );
+
+            R h( h1 );
+            test_reset( h, h0 );
+        }
+
+        {
+            R h( 12345 );
+            h.update( data, 19 );
+
+            h.reseed( seeds[ i ] );
+            test_reset( h, h0 );
+        }
+
+        {
+            H h( 12345 );
+            h.update( data, 19 );
+
+            h.reseed( seeds[ i ] );
+            test_reseed( h, H( seeds[ i ] ) );
+        }
+    }
+
+    std::size_t const key_sizes[] = { 0, 1, 8, 16, 64, 65, 150 };
+
+    for( std::size_t i = 0; i < sizeof(key_sizes) / sizeof(key_sizes[0]); ++i )
+    {
+        std::size_t n = key_sizes[ i ];
+
+        R h0( data + 3, n );
+
+        {
+            R h( data + 3, n );
+            test_reset( h, h0 );
+        }
+
+        {
+            R h( data + 50, 40 );
+            h.update( data, 33 );
+
+            h.reseed( data + 3, n );
+            test_reset( h, h0 );
+        }
+
+        {
+            H h( data + 50, 40 );
+            h.update( data, 33 );
+
+            h.reseed( data + 3, n );
+            test_reseed( h, H( data + 3, n ) );
+        }
+    }
+
+    {
+        // the prototype can be in any state at a block boundary
+
+        H h1( 7 );
+        h1.update( data, 128 );
+
+        R h( h1 );
+        R h0( h1 );
+
+        test_reset( h, h0 );
+    }
+}
+
+// the prototype of a hash that isn't a block hash can be in any state
+
+template<class H> void test_partial()
+{
+    using R = boost::hash2::resettable<H>;
+
+    H h1( 7 );
+    h1.update( data, 91 );
+
+    R h( h1 );
+    R h0( h1 );
+
+    test_reset( h, h0 );
+}
+
+// a block hash keeps only the chaining words and the length, so it
+// can only be reset to a block boundary
+
+template<class H> void test_block()
+{
+    using R = boost::hash2::resettable<H>;
+
+    H h1( 7 );
+    h1.update( data, 91 );
+
+    BOOST_TEST_THROWS( (void)R( h1 ), std::invalid_argument );
+
+    BOOST_TEST_LT( sizeof( R ), 2 * sizeof( H ) );
+
+    // initial() reconstructs the prototype
+
+    R h( 7 );
+
+    H h2 = h.initial();
+    H h3( 7 );
+
+    h2.update( data, 65 );
+    h3.update( data, 65 );
+
+    BOOST_TEST( h2.result() == h3.result() );
+}
+
+int main()
+{
+    for( std::size_t i = 0; i < sizeof(data); ++i )
+    {
+        data[ i ] = static_cast<unsigned char>( i * 0x9D + 0x3B );
+    }
+
+    using namespace boost::hash2;
+
+    test<fnv1a_32>();
+    test<fnv1a_64>();
+    test<xxhash_32>();
+    test<xxhash_64>();
+    test<siphash_32>();
+    test<siphash_64>();
+    test<md5_128>();
+    test<sha1_160>();
+    test<sha2_256>();
+    test<sha2_224>();
+    test<sha2_512>();
+    test<sha2_384>();
+    test<sha2_512_224>();
+    test<sha2_512_256>();
+    test<ripemd_128>();
+    test<ripemd_160>();
+
+    test<hmac_md5_128>();
+    test<hmac_sha1_160>();
+    test<hmac_sha2_256>();
+    test<hmac_sha2_512>();
+    test<hmac_ripemd_160>();
+
+    test_partial<fnv1a_32>();
+    test_partial<xxhash_64>();
+    test_partial<siphash_64>();
+
+    test_block<md5_128>();
+    test_block<sha1_160>();
+    test_block<sha2_256>();
+    test_block<sha2_512>();
+    test_block<ripemd_160>();
+
+    test_block<hmac_md5_128>();
+    test_block<hmac_sha2_256>();
+    test_block<hmac_sha2_512>();
+
+    return boost::report_errors();
+}
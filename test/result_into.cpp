@@ -0,0 +1,137 @@
+// Copyright 2024 Peter Dimov.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/hash2/result_into.hpp>
+#include <boost/hash2/fnv1a.hpp>
+#include <boost/hash2/xxhash.hpp>
+#include <boost/hash2/siphash.hpp>
+#include <boost/hash2/md5.hpp>
+#include <boost/hash2/sha1.hpp>
+#include <boost/hash2/sha2.hpp>
+#include <boost/hash2/ripemd.hpp>
+#include <boost/hash2/detail/write.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/core/lightweight_test_trait.hpp>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+void append( std::vector<unsigned char>& v, std::uint32_t r )
+{
+    unsigned char w[ 4 ] = {};
+    boost::hash2::detail::write32le( w, r );
+    v.insert( v.end(), w, w + 4 );
+}
+
+void append( std::vector<unsigned char>& v, std::uint64_t r )
+{
+    unsigned char w[ 8 ] = {};
+    boost::hash2::detail::write64le( w, r );
+    v.insert( v.end(), w, w + 8 );
+}
+
+template<std::size_t N> void append( std::vector<unsigned char>& v, boost::hash2::digest<N> const& r )
+{
+    v.insert( v.end(), r.begin(), r.end() );
+}
+
+template<class H> void test()
+{
+    for( std::size_t n = 0; n < 150; n += 7 )
+    {
+        H h0( 0x0102 );
+        h0.update( "message", 7 );
+
+        std::vector<unsigned char> v1;
+
+        {
+            H h( h0 );
+
+            while( v1.size() < n )
+            {
+                append( v1, h.result() );
+            }
+
+            v1.resize( n );
+        }
+
+        {
+            std::vector<unsigned char> v2( n );
+
+            H h( h0 );
+            boost::hash2::result_into( h, v2.data(), v2.size() );
+
+            BOOST_TEST( v1 == v2 );
+        }
+
+        {
+            std::vector<char> v2( n );
+
+            H h( h0 );
+            boost::hash2::result_into( h, static_cast<void*>( v2.data() ), v2.size() );
+
+            BOOST_TEST( std::vector<unsigned char>( v2.begin(), v2.end() ) == v1 );
+        }
+    }
+}
+
+// an algorithm with a native extendable output
+
+struct xof
+{
+    using result_type = std::uint32_t;
+
+    unsigned char c = 0;
+
+    void update( void const*, std::size_t )
+    {
+    }
+
+    result_type result()
+    {
+        return 0;
+    }
+
+    void result_into( unsigned char* p, std::size_t n )
+    {
+        for( std::size_t i = 0; i < n; ++i )
+        {
+            p[ i ] = ++c;
+        }
+    }
+};
+
+int main()
+{
+    using namespace boost::hash2;
+
+    test<fnv1a_32>();
+    test<fnv1a_64>();
+    test<xxhash_32>();
+    test<xxhash_64>();
+    test<siphash_32>();
+    test<siphash_64>();
+    test<md5_128>();
+    test<sha1_160>();
+    test<sha2_256>();
+    test<sha2_224>();
+    test<sha2_512>();
+    test<ripemd_160>();
+    test<hmac_sha2_256>();
+
+    BOOST_TEST_TRAIT_FALSE((detail::has_result_into<sha2_256>));
+    BOOST_TEST_TRAIT_TRUE((detail::has_result_into<xof>));
+
+    {
+        xof h;
+
+        unsigned char w[ 5 ] = {};
+        result_into( h, w, 5 );
+
+        BOOST_TEST_EQ( w[ 0 ], 1 );
+        BOOST_TEST_EQ( w[ 4 ], 5 );
+    }
+
+    return boost::report_errors();
+}
@@ -0,0 +1,201 @@
+// Copyright 2024 Peter Dimov.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/hash2/rolling_hash.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/config.hpp>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+std::vector<unsigned char> data( 1000 );
+
+template<class H> std::uint64_t window_hash( H const& h0, unsigned char const* p, std::size_t n )
+{
+    H h( h0 );
+
+    h.reset();
+    h.update( p, n );
+
+    return h.value();
+}
+
+template<class H> void test( H h )
+{
+    std::size_t const W = H::window;
+
+    // scan agrees with hashing each window from scratch
+
+    std::size_t calls = 0;
+    std::size_t last = 0;
+
+    h.scan( data.data(), data.size(), [&]( std::size_t i, std::uint64_t v ){
+
+        BOOST_TEST_EQ( i, W + calls );
+        BOOST_TEST_EQ( v, window_hash( h, data.data() + i - W, W ) );
+
+        ++calls;
+        last = i;
+
+    });
+
+    BOOST_TEST_EQ( calls, data.size() - W + 1 );
+    BOOST_TEST_EQ( last, data.size() );
+
+    // roll agrees with scan
+
+    {
+        H h2( h );
+
+        h2.reset();
+        h2.update( data.data(), W );
+
+        for( std::size_t i = W; i < data.size(); ++i )
+        {
+            h2.roll( data[ i - W ], data[ i ] );
+            BOOST_TEST_EQ( h2.value(), window_hash( h, data.data() + i + 1 - W, W ) );
+        }
+
+        BOOST_TEST_EQ( h2.value(), h.value() );
+    }
+
+    // equal windows at different offsets hash the same
+
+    {
+        std::vector<unsigned char> v( data.begin(), data.begin() + W );
+        v.insert( v.end(), data.begin() + 7, data.begin() + 7 + 3 * W );
+        v.insert( v.end(), data.begin(), data.begin() + W );
+
+        std::uint64_t first = 0;
+
+        h.scan( v.data(), v.size(), [&]( std::size_t i, std::uint64_t x ){
+
+            if( i == W ) first = x;
+            if( i == v.size() ) BOOST_TEST_EQ( x, first );
+
+        });
+    }
+
+    // too short for a window
+
+    {
+        std::size_t k = 0;
+
+        h.scan( data.data(), W - 1, [&]( std::size_t, std::uint64_t ){ ++k; } );
+
+        BOOST_TEST_EQ( k, 0u );
+    }
+}
+
+template<class H> void test_seeds()
+{
+    std::size_t const W = H::window;
+
+    H h0, h1( 0 ), h2( 1 ), h3( 1 ), h4( data.data(), 16 ), h5( static_cast<void const*>( data.data() ), 16 );
+
+    std::uint64_t v0 = window_hash( h0, data.data(), W );
+    std::uint64_t v1 = window_hash( h1, data.data(), W );
+    std::uint64_t v2 = window_hash( h2, data.data(), W );
+    std::uint64_t v3 = window_hash( h3, data.data(), W );
+    std::uint64_t v4 = window_hash( h4, data.data(), W );
+    std::uint64_t v5 = window_hash( h5, data.data(), W );
+
+    // a zero seed is equivalent to no seed, as with siphash_64
+    BOOST_TEST_EQ( v0, v1 );
+
+    BOOST_TEST_NE( v0, v2 );
+    BOOST_TEST_EQ( v2, v3 );
+    BOOST_TEST_NE( v2, v4 );
+    BOOST_TEST_EQ( v4, v5 );
+}
+
+#if !defined(BOOST_NO_CXX14_CONSTEXPR)
+
+template<class H> BOOST_CXX14_CONSTEXPR std::uint64_t cx_rolled()
+{
+    unsigned char buf[ 80 ] = {};
+
+    for( int i = 0; i < 80; ++i )
+    {
+        buf[ i ] = static_cast<unsigned char>( i * 7 + 1 );
+    }
+
+    H h( 5 );
+    h.update( buf, H::window );
+
+    for( std::size_t i = H::window; i < 80; ++i )
+    {
+        h.roll( buf[ i - H::window ], buf[ i ] );
+    }
+
+    return h.value();
+}
+
+template<class H> BOOST_CXX14_CONSTEXPR std::uint64_t cx_direct()
+{
+    unsigned char buf[ 80 ] = {};
+
+    for( int i = 0; i < 80; ++i )
+    {
+        buf[ i ] = static_cast<unsigned char>( i * 7 + 1 );
+    }
+
+    H h( 5 );
+    h.update( buf + 80 - H::window, H::window );
+
+    return h.value();
+}
+
+static_assert( cx_rolled< boost::hash2::rabin_karp_64<16> >() == cx_direct< boost::hash2::rabin_karp_64<16> >(), "rabin_karp_64" );
+static_assert( cx_rolled< boost::hash2::buzhash_64<16> >() == cx_direct< boost::hash2::buzhash_64<16> >(), "buzhash_64" );
+static_assert( cx_rolled< boost::hash2::gear_64 >() == cx_direct< boost::hash2::gear_64 >(), "gear_64" );
+
+#endif
+
+int main()
+{
+    std::uint32_t x = 0x9E3779B9u;
+
+    for( std::size_t i = 0; i < data.size(); ++i )
+    {
+        x = x * 1664525u + 1013904223u;
+        data[ i ] = static_cast<unsigned char>( x >> 24 );
+    }
+
+    using namespace boost::hash2;
+
+    test( rabin_karp_64<1>() );
+    test( rabin_karp_64<16>( 7 ) );
+    test( rabin_karp_64<48>( data.data(), 5 ) );
+
+    test( buzhash_64<1>() );
+    test( buzhash_64<32>( 7 ) );
+    test( buzhash_64<64>() );
+    test( buzhash_64<100>( data.data(), 5 ) );
+
+    test( gear_64() );
+    test( gear_64( 7 ) );
+
+    test_seeds< rabin_karp_64<32> >();
+    test_seeds< buzhash_64<32> >();
+    test_seeds< gear_64 >();
+
+    {
+        // the tables of the algorithms are independent
+
+        rabin_karp_64<1> h1;
+        buzhash_64<1> h2;
+        gear_64 h3;
+
+        h1.update( data.data(), 1 );
+        h2.update( data.data(), 1 );
+        h3.update( data.data(), 1 );
+
+        BOOST_TEST_NE( h1.value(), h2.value() );
+        BOOST_TEST_NE( h1.value(), h3.value() );
+        BOOST_TEST_NE( h2.value(), h3.value() );
+    }
+
+    return boost::report_errors();
+}
@@ -0,0 +1,162 @@
+// Copyright 2024 Peter Dimov.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/hash2/sha2_256d.hpp>
+#include <boost/hash2/sha2.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/config.hpp>
+#include <string>
+#include <vector>
+#include <cstring>
+#include <cstddef>
+
+using boost::hash2::digest;
+using boost::hash2::sha2_256;
+
+static std::vector<unsigned char> from_hex( char const* str )
+{
+    auto f = []( char c ) { return ( c >= 'a' ? c - 'a' + 10 : c - '0' ); };
+
+    std::vector<unsigned char> v;
+
+    while( *str != '\0' )
+    {
+        v.push_back( static_cast<unsigned char>( ( f( str[ 0 ] ) << 4 ) + f( str[ 1 ] ) ) );
+        str += 2;
+    }
+
+    return v;
+}
+
+static digest<32> sha2_256_ref( unsigned char const* p, std::size_t n )
+{
+    sha2_256 h;
+    h.update( p, n );
+
+    return h.result();
+}
+
+static digest<32> sha2_256d_ref( unsigned char const* p, std::size_t n )
+{
+    digest<32> r = sha2_256_ref( p, n );
+    return sha2_256_ref( r.data(), r.size() );
+}
+
+static digest<32> load( unsigned char const* p )
+{
+    digest<32> r;
+    std::memcpy( r.data(), p, 32 );
+
+    return r;
+}
+
+static void test_vectors()
+{
+    using boost::hash2::sha2_256d;
+
+    BOOST_TEST_EQ( to_string( sha2_256d( "hello", 5 ) ), std::string( "9595c9df90075148eb06860365df33584b75bff782a510c6cd4883a419833d50" ) );
+
+    // the Bitcoin genesis block header; the block hash is this digest, byte-reversed
+
+    std::vector<unsigned char> v = from_hex(
+        "0100000000000000000000000000000000000000000000000000000000000000"
+        "000000003ba3edfd7a7b12b27ac72c3e67768f617fc81bc3888a51323a9fb8aa"
+        "4b1e5e4a29ab5f49ffff001d1dac2b7c" );
+
+    BOOST_TEST_EQ( to_string( sha2_256d( v.data(), v.size() ) ), std::string( "6fe28c0ab6f1b372c1a6a246ae63f74f931e8365e15a089c68d6190000000000" ) );
+}
+
+static void test_fixed( std::vector<unsigned char> const& data )
+{
+    for( std::size_t i = 0; i + 64 <= data.size(); i += 64 )
+    {
+        unsigned char const* p = data.data() + i;
+
+        BOOST_TEST( boost::hash2::sha2_256_64( p ) == sha2_256_ref( p, 64 ) );
+        BOOST_TEST( boost::hash2::sha2_256d_64( p ) == sha2_256d_ref( p, 64 ) );
+    }
+
+    for( std::size_t n = 0; n < 200; n += 7 )
+    {
+        BOOST_TEST( boost::hash2::sha2_256d( data.data(), n ) == sha2_256d_ref( data.data(), n ) );
+    }
+}
+
+static void test_batch( std::vector<unsigned char> const& data )
+{
+    for( std::size_t n = 0; n <= 11; ++n )
+    {
+        std::vector<unsigned char> out1( n * 32 + 1, 0xEE );
+        std::vector<unsigned char> out2( n * 32 + 1, 0xEE );
+
+        boost::hash2::sha2_256_64_batch( data.data(), n, out1.data() );
+        boost::hash2::sha2_256d_64_batch( data.data(), n, out2.data() );
+
+        for( std::size_t i = 0; i < n; ++i )
+        {
+            unsigned char const* p = data.data() + i * 64;
+
+            BOOST_TEST( load( out1.data() + i * 32 ) == sha2_256_ref( p, 64 ) );
+            BOOST_TEST( load( out2.data() + i * 32 ) == sha2_256d_ref( p, 64 ) );
+        }
+
+        // nothing past the last digest is written
+        BOOST_TEST_EQ( out1[ n * 32 ], 0xEE );
+        BOOST_TEST_EQ( out2[ n * 32 ], 0xEE );
+    }
+}
+
+#if !defined(BOOST_NO_CXX14_CONSTEXPR)
+
+BOOST_CXX14_CONSTEXPR digest<32> cx_sha2_256d_64()
+{
+    unsigned char buf[ 64 ] = {};
+
+    for( int i = 0; i < 64; ++i )
+    {
+        buf[ i ] = static_cast<unsigned char>( i );
+    }
+
+    return boost::hash2::sha2_256d_64( buf );
+}
+
+BOOST_CXX14_CONSTEXPR digest<32> cx_sha2_256d_64_ref()
+{
+    unsigned char buf[ 64 ] = {};
+
+    for( int i = 0; i < 64; ++i )
+    {
+        buf[ i ] = static_cast<unsigned char>( i );
+    }
+
+    sha2_256 h1;
+    h1.update( buf, 64 );
+
+    digest<32> r = h1.result();
+
+    sha2_256 h2;
+    h2.update( r.data(), r.size() );
+
+    return h2.result();
+}
+
+static_assert( cx_sha2_256d_64() == cx_sha2_256d_64_ref(), "constexpr sha2_256d_64" );
+
+#endif
+
+int main()
+{
+    std::vector<unsigned char> data( 64 * 12 );
+
+    for( std::size_t i = 0; i < data.size(); ++i )
+    {
+        data[ i ] = static_cast<unsigned char>( i * 0x9D + 0x3B );
+    }
+
+    test_vectors();
+    test_fixed( data );
+    test_batch( data );
+
+    return boost::report_errors();
+}
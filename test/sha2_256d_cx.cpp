@@ -0,0 +1,122 @@
+// Copyright 2024 Peter Dimov.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/hash2/sha2_256d.hpp>
+#include <boost/hash2/digest.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/config.hpp>
+
+#if defined(BOOST_MSVC) && BOOST_MSVC < 1920
+# pragma warning(disable: 4307) // integral constant overflow
+#endif
+
+#define STATIC_ASSERT(...) static_assert(__VA_ARGS__, #__VA_ARGS__)
+
+#if defined(BOOST_NO_CXX14_CONSTEXPR)
+# define TEST_EQ(x1, x2) BOOST_TEST_EQ(x1, x2)
+#else
+# define TEST_EQ(x1, x2) BOOST_TEST_EQ(x1, x2); STATIC_ASSERT(x1 == x2)
+#endif
+
+BOOST_CXX14_CONSTEXPR unsigned char to_byte( char c )
+{
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return 0xff;
+}
+
+template<std::size_t N, std::size_t M = ( N - 1 ) / 2>
+BOOST_CXX14_CONSTEXPR boost::hash2::digest<M> digest_from_hex( char const (&str)[ N ] )
+{
+    boost::hash2::digest<M> dgst = {};
+    auto* p = dgst.data();
+    for( unsigned i = 0; i < M; ++i ) {
+        auto c1 = to_byte( str[ 2 * i ] );
+        auto c2 = to_byte( str[ 2 * i + 1 ] );
+        p[ i ] = ( c1 << 4 ) | c2;
+    }
+    return dgst;
+}
+
+// message k of a batch; byte i is k + 3 * i
+
+BOOST_CXX14_CONSTEXPR void fill_message( unsigned char* p, unsigned k )
+{
+    for( unsigned i = 0; i < 64; ++i ) { p[ i ] = static_cast<unsigned char>( k + 3 * i ); }
+}
+
+BOOST_CXX14_CONSTEXPR boost::hash2::digest<32> test_64( unsigned k )
+{
+    unsigned char buf[ 64 ] = {};
+    fill_message( buf, k );
+
+    return boost::hash2::sha2_256_64( buf );
+}
+
+BOOST_CXX14_CONSTEXPR boost::hash2::digest<32> test_d_64( unsigned k )
+{
+    unsigned char buf[ 64 ] = {};
+    fill_message( buf, k );
+
+    return boost::hash2::sha2_256d_64( buf );
+}
+
+// nine messages, so that both the four lane and the one lane paths are used
+
+template<bool Double> BOOST_CXX14_CONSTEXPR boost::hash2::digest<32> test_batch( unsigned k )
+{
+    unsigned char buf[ 9 * 64 ] = {};
+
+    for( unsigned i = 0; i < 9; ++i ) { fill_message( buf + i * 64, i ); }
+
+    unsigned char out[ 9 * 32 ] = {};
+
+    if( Double )
+    {
+        boost::hash2::sha2_256d_64_batch( buf, 9, out );
+    }
+    else
+    {
+        boost::hash2::sha2_256_64_batch( buf, 9, out );
+    }
+
+    boost::hash2::digest<32> r = {};
+    for( unsigned i = 0; i < 32; ++i ) { r.data()[ i ] = out[ k * 32 + i ]; }
+
+    return r;
+}
+
+template<std::size_t N> BOOST_CXX14_CONSTEXPR boost::hash2::digest<32> test_d( char const (&str)[ N ] )
+{
+    std::size_t const M = N - 1; // strip off null-terminator
+
+    unsigned char buf[ M ] = {};
+    for( unsigned i = 0; i < M; ++i ){ buf[i] = str[i]; }
+
+    return boost::hash2::sha2_256d( buf, M );
+}
+
+int main()
+{
+    TEST_EQ( test_64( 0 ), digest_from_hex( "1a0e0ecf84382961a85aa8629e98aefcfeffdcf0fd74a6dd49d55d9706477ab2" ) );
+    TEST_EQ( test_64( 5 ), digest_from_hex( "56c7bd716afe07bd031383060f00587dfa7550390a3b5a9e4cb391067aaa02fc" ) );
+
+    TEST_EQ( test_d_64( 0 ), digest_from_hex( "e904e0c1103556f30cb437223f74c4df4c5648b62be13059715fe9f1a0785698" ) );
+    TEST_EQ( test_d_64( 5 ), digest_from_hex( "4cfa3dfc9f3b1a07ad07e8727e01a2122d15f2d54cb30fdfc4989a87b7de139d" ) );
+
+    TEST_EQ( test_batch<false>( 5 ), digest_from_hex( "56c7bd716afe07bd031383060f00587dfa7550390a3b5a9e4cb391067aaa02fc" ) );
+    TEST_EQ( test_batch<false>( 8 ), digest_from_hex( "6bc7bef9b7a5b423a2bb80b1c3a3127cb0d445db3175d3809ffa72240f0cf408" ) );
+
+    TEST_EQ( test_batch<true>( 5 ), digest_from_hex( "4cfa3dfc9f3b1a07ad07e8727e01a2122d15f2d54cb30fdfc4989a87b7de139d" ) );
+    TEST_EQ( test_batch<true>( 8 ), digest_from_hex( "e72a6443a546866dd370d37089c34aa50fce2341c9404685232f28fda9a71c4c" ) );
+
+    {
+        constexpr char const str1[] = "hello";
+
+        TEST_EQ( test_d( str1 ), digest_from_hex( "9595c9df90075148eb06860365df33584b75bff782a510c6cd4883a419833d50" ) );
+    }
+
+    return boost::report_errors();
+}
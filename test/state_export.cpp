@@ -0,0 +1,195 @@
+// Copyright 2024 Peter Dimov.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/hash2/md5.hpp>
+#include <boost/hash2/sha1.hpp>
+#include <boost/hash2/sha2.hpp>
+#include <boost/hash2/ripemd.hpp>
+#include <boost/hash2/resettable.hpp>
+#include <boost/hash2/detail/read.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <stdexcept>
+#include <cstddef>
+#include <cstdint>
+
+unsigned char data[ 700 ];
+
+template<class H> void test( unsigned char id, std::size_t state_bytes )
+{
+    std::size_t const N = H::block_size;
+    std::size_t const S = H::state_size;
+
+    BOOST_TEST_EQ( S, 16 + state_bytes + N );
+
+    H h0;
+    h0.update( data, sizeof(data) );
+
+    typename H::result_type const r = h0.result();
+
+    for( std::size_t m = 0; m < sizeof(data); m += 13 )
+    {
+        H h1( 7 );
+        h1.update( data, 5 );
+
+        H h2;
+        h2.update( data, m );
+
+        unsigned char st[ H::state_size ];
+        h2.export_state( st );
+
+        BOOST_TEST_EQ( st[ 0 ], 1 );
+        BOOST_TEST_EQ( st[ 1 ], id );
+        BOOST_TEST_EQ( boost::hash2::detail::read64le( st + 8 ), m );
+
+        BOOST_TEST( h1.import_state( st ) );
+
+        h1.update( data + m, sizeof(data) - m );
+        BOOST_TEST( h1.result() == r );
+
+        // the exported state is independent of the original object
+
+        h2.update( data + m, sizeof(data) - m );
+        BOOST_TEST( h2.result() == r );
+
+        // resettable resets to the imported state, at a block boundary
+
+        if( m % H::block_size != 0 )
+        {
+            H h4( 7 );
+            BOOST_TEST( h4.import_state( st ) );
+
+            BOOST_TEST_THROWS( (void)boost::hash2::resettable<H>( h4 ), std::invalid_argument );
+        }
+        else
+        {
+            H h4( 7 );
+            BOOST_TEST( h4.import_state( st ) );
+
+            boost::hash2::resettable<H> h5( h4 );
+
+            for( int i = 0; i < 3; ++i )
+            {
+                h5.update( data + m, sizeof(data) - m );
+                BOOST_TEST( h5.result() == r );
+
+                h5.reset();
+            }
+
+            unsigned char st5[ H::state_size ];
+            h5.get().export_state( st5 );
+
+            for( std::size_t i = 0; i < H::state_size; ++i )
+            {
+                BOOST_TEST_EQ( st5[ i ], st[ i ] );
+            }
+        }
+
+        // rejected states leave the object unchanged
+
+        H h3;
+        h3.update( data, m );
+
+        unsigned char st2[ H::state_size ];
+
+        st2[ 0 ] = 0;
+        h3.export_state( st2 ); // overwritten
+
+        {
+            unsigned char st3[ H::state_size ];
+
+            for( std::size_t i = 0; i < H::state_size; ++i ) st3[ i ] = st[ i ];
+            st3[ 0 ] = 2;
+
+            BOOST_TEST( !h3.import_state( st3 ) );
+        }
+
+        {
+            unsigned char st3[ H::state_size ];
+
+            for( std::size_t i = 0; i < H::state_size; ++i ) st3[ i ] = st[ i ];
+            st3[ 1 ] = static_cast<unsigned char>( id + 1 );
+
+            BOOST_TEST( !h3.import_state( st3 ) );
+        }
+
+        {
+            unsigned char st3[ H::state_size ];
+
+            for( std::size_t i = 0; i < H::state_size; ++i ) st3[ i ] = st[ i ];
+            st3[ 5 ] = 1;
+
+            BOOST_TEST( !h3.import_state( st3 ) );
+        }
+
+        if( m % N != N - 1 )
+        {
+            unsigned char st3[ H::state_size ];
+
+            for( std::size_t i = 0; i < H::state_size; ++i ) st3[ i ] = st[ i ];
+            st3[ H::state_size - 1 ] = 0x80;
+
+            BOOST_TEST( !h3.import_state( st3 ) );
+        }
+
+        unsigned char st4[ H::state_size ];
+        h3.export_state( st4 );
+
+        for( std::size_t i = 0; i < H::state_size; ++i )
+        {
+            BOOST_TEST_EQ( st2[ i ], st4[ i ] );
+        }
+    }
+}
+
+int main()
+{
+    for( std::size_t i = 0; i < sizeof(data); ++i )
+    {
+        data[ i ] = static_cast<unsigned char>( i * 0x9D + 0x3B );
+    }
+
+    using namespace boost::hash2;
+
+    test<md5_128>( 1, 16 );
+    test<sha1_160>( 2, 20 );
+    test<sha2_256>( 3, 32 );
+    test<sha2_224>( 4, 32 );
+    test<sha2_512>( 5, 64 );
+    test<sha2_384>( 6, 64 );
+    test<sha2_512_224>( 7, 64 );
+    test<sha2_512_256>( 8, 64 );
+    test<ripemd_128>( 9, 16 );
+    test<ripemd_160>( 10, 20 );
+
+    // the layout is fixed
+
+    {
+        sha2_256 h;
+        h.update( "abc", 3 );
+
+        unsigned char st[ sha2_256::state_size ];
+        h.export_state( st );
+
+        unsigned char const expected[ 28 ] =
+        {
+            1, 3, 0, 0, 0, 0, 0, 0,
+            3, 0, 0, 0, 0, 0, 0, 0,
+            0x67, 0xe6, 0x09, 0x6a,
+            0x85, 0xae, 0x67, 0xbb,
+            0x72, 0xf3, 0x6e, 0x3c,
+        };
+
+        for( std::size_t i = 0; i < 28; ++i )
+        {
+            BOOST_TEST_EQ( st[ i ], expected[ i ] );
+        }
+
+        BOOST_TEST_EQ( st[ 48 ], 'a' );
+        BOOST_TEST_EQ( st[ 49 ], 'b' );
+        BOOST_TEST_EQ( st[ 50 ], 'c' );
+        BOOST_TEST_EQ( st[ 51 ], 0 );
+    }
+
+    return boost::report_errors();
+}
@@ -0,0 +1,269 @@
+// Copyright 2024 Peter Dimov.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/hash2/tree_hash.hpp>
+#include <boost/hash2/sha2.hpp>
+#include <boost/hash2/md5.hpp>
+#include <boost/hash2/ripemd.hpp>
+#include <boost/hash2/xxhash.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+std::vector<unsigned char> data( 5000 );
+
+template<class H> typename H::result_type leaf_ref( unsigned char const* p, std::size_t n )
+{
+    H h;
+
+    unsigned char c = 0x00;
+    h.update( &c, 1 );
+    h.update( p, n );
+
+    return h.result();
+}
+
+template<class R> void append_result( std::vector<unsigned char>& v, R const& r )
+{
+    unsigned char tmp[ sizeof(R) ] = {};
+    boost::hash2::detail::write_result( tmp, sizeof(R), r );
+
+    v.insert( v.end(), tmp, tmp + sizeof(R) );
+}
+
+template<class H> typename H::result_type node_ref( typename H::result_type const& a, typename H::result_type const& b )
+{
+    std::vector<unsigned char> v( 1, 0x01 );
+
+    append_result( v, a );
+    append_result( v, b );
+
+    H h;
+    h.update( v.data(), v.size() );
+
+    return h.result();
+}
+
+// straightforward level by level construction
+
+template<class H, std::size_t L> typename H::result_type root_ref( unsigned char const* p, std::size_t n )
+{
+    using R = typename H::result_type;
+
+    std::vector<R> level;
+
+    std::size_t i = 0;
+
+    do
+    {
+        std::size_t k = n - i < L? n - i: L;
+        level.push_back( leaf_ref<H>( p + i, k ) );
+        i += k;
+    }
+    while( i < n );
+
+    while( level.size() > 1 )
+    {
+        std::vector<R> next;
+
+        for( std::size_t j = 0; j < level.size(); j += 2 )
+        {
+            next.push_back( j + 1 < level.size()? node_ref<H>( level[ j ], level[ j + 1 ] ): level[ j ] );
+        }
+
+        level.swap( next );
+    }
+
+    return level[ 0 ];
+}
+
+template<class H, std::size_t L> void test()
+{
+    using T = boost::hash2::tree_hash<H, L>;
+    using R = typename H::result_type;
+
+    std::size_t const sizes[] = { 0, 1, L - 1, L, L + 1, 2 * L, 3 * L + 5, 7 * L, 16 * L, 16 * L + 1, data.size() };
+
+    for( std::size_t k = 0; k < sizeof(sizes) / sizeof(sizes[0]); ++k )
+    {
+        std::size_t n = sizes[ k ];
+
+        if( n > data.size() ) continue;
+
+        R r0 = root_ref<H, L>( data.data(), n );
+
+        {
+            T t;
+            t.update( data.data(), n );
+
+            BOOST_TEST_EQ( t.size(), n );
+            BOOST_TEST_EQ( t.leaf_count(), n == 0? 1: ( n - 1 ) / L + 1 );
+
+            BOOST_TEST( t.root() == r0 );
+            BOOST_TEST( t.root() == r0 );
+        }
+
+        {
+            T t;
+            t.update( data.data(), n, 4 );
+
+            BOOST_TEST( t.root() == r0 );
+        }
+
+        {
+            // uneven pieces, with root() computed in between
+
+            T t;
+
+            std::size_t const steps[] = { 1, 3, L - 2, L, 2 * L + 1, 5 };
+
+            for( std::size_t i = 0, j = 0; i < n; ++j )
+            {
+                std::size_t m = steps[ j % 6 ];
+                if( m > n - i ) m = n - i;
+
+                t.update( data.data() + i, m, 2 );
+                i += m;
+
+                t.root();
+            }
+
+            BOOST_TEST( t.root() == r0 );
+        }
+
+        {
+            T t;
+            t.update( data.data(), n );
+
+            R r = t.root();
+
+            for( std::size_t i = 0; i < t.leaf_count(); ++i )
+            {
+                std::vector<typename T::proof_node> proof = t.proof( i );
+
+                unsigned char const* p = data.data() + i * L;
+                std::size_t m = n - i * L < L? n - i * L: L;
+
+                BOOST_TEST( t.verify( p, m, proof, r ) );
+
+                if( m > 0 )
+                {
+                    // a modified leaf doesn't verify
+                    std::vector<unsigned char> w( p, p + m );
+                    w[ m / 2 ] ^= 0x20;
+
+                    BOOST_TEST( !t.verify( w.data(), m, proof, r ) );
+                }
+
+                if( t.leaf_count() > 1 )
+                {
+                    // neither does a leaf checked against the wrong proof
+                    std::vector<typename T::proof_node> proof2 = t.proof( ( i + 1 ) % t.leaf_count() );
+
+                    if( m == L )
+                    {
+                        BOOST_TEST( !t.verify( p, m, proof2, r ) );
+                    }
+                }
+            }
+        }
+    }
+
+    // explicit small cases
+
+    {
+        T t;
+        BOOST_TEST( t.root() == t.hash_leaf( nullptr, 0 ) );
+    }
+
+    {
+        T t;
+        t.update( data.data(), 2 * L );
+
+        BOOST_TEST( t.root() == t.hash_node( t.hash_leaf( data.data(), L ), t.hash_leaf( data.data() + L, L ) ) );
+    }
+
+    // seeded trees differ
+
+    {
+        T t1, t2( 7 ), t3( data.data(), 16 );
+
+        t1.update( data.data(), 3 * L );
+        t2.update( data.data(), 3 * L );
+        t3.update( data.data(), 3 * L );
+
+        BOOST_TEST( t1.root() != t2.root() );
+        BOOST_TEST( t1.root() != t3.root() );
+        BOOST_TEST( t2.root() != t3.root() );
+
+        T t4( 7 );
+        t4.update( data.data(), 3 * L );
+
+        BOOST_TEST( t4.root() == t2.root() );
+    }
+}
+
+// inputs large enough for the leaves to be hashed on several threads
+
+template<class H> void test_large()
+{
+    using T = boost::hash2::tree_hash<H, 1024>;
+
+    std::vector<unsigned char> v( ( 3 << 20 ) + 100 );
+
+    for( std::size_t i = 0; i < v.size(); ++i )
+    {
+        v[ i ] = data[ i % data.size() ] ^ static_cast<unsigned char>( i >> 12 );
+    }
+
+    typename H::result_type r0 = root_ref<H, 1024>( v.data(), v.size() );
+
+    std::size_t const threads[] = { 0, 2, 4, 16 };
+
+    for( std::size_t i = 0; i < sizeof(threads) / sizeof(threads[0]); ++i )
+    {
+        T t;
+        t.update( v.data(), v.size(), threads[ i ] );
+
+        BOOST_TEST( t.root() == r0 );
+    }
+
+    {
+        // a small update after a large one
+
+        T t;
+
+        t.update( v.data(), 100, 4 );
+        t.update( v.data() + 100, v.size() - 100, 4 );
+
+        BOOST_TEST( t.root() == r0 );
+    }
+}
+
+int main()
+{
+    // not periodic, so that no two leaves are equal
+
+    std::uint32_t x = 0x9E3779B9u;
+
+    for( std::size_t i = 0; i < data.size(); ++i )
+    {
+        x = x * 1664525u + 1013904223u;
+        data[ i ] = static_cast<unsigned char>( x >> 24 );
+    }
+
+    using namespace boost::hash2;
+
+    test<sha2_256, 64>();
+    test<sha2_256, 1024>();
+    test<md5_128, 100>();
+    test<ripemd_160, 256>();
+    test<xxhash_64, 32>();
+
+    test_large<sha2_256>();
+    test_large<xxhash_64>();
+
+    return boost::report_errors();
+}
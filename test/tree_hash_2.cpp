@@ -0,0 +1,357 @@
+// Copyright 2024 Peter Dimov.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/hash2/tree_hash.hpp>
+#include <boost/hash2/sha2.hpp>
+#include <boost/hash2/md5.hpp>
+#include <boost/hash2/xxhash.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <vector>
+#include <cstdio>
+#include <cstddef>
+#include <cstdint>
+
+std::vector<unsigned char> data( 5000 );
+
+std::uint32_t rng = 0x9E3779B9u;
+
+static std::uint32_t next()
+{
+    rng = rng * 1664525u + 1013904223u;
+    return rng >> 8;
+}
+
+template<class T> typename T::result_type full_root( std::vector<unsigned char> const& v )
+{
+    T t;
+    t.update( v.data(), v.size() );
+
+    return t.root();
+}
+
+template<class H, std::size_t L> void test_rehash( std::size_t n )
+{
+    using T = boost::hash2::tree_hash<H, L>;
+    using range = typename T::range;
+
+    std::vector<unsigned char> v( data.begin(), data.begin() + n );
+
+    T t1, t2, t3;
+
+    t1.update( v.data(), n );
+    t1.root();
+
+    // t2 isn't built before the rehash
+    t2.update( v.data(), n );
+
+    // t3 is built, and rehashes on several threads
+    t3.update( v.data(), n );
+    t3.root();
+
+    for( int k = 0; k < 8; ++k )
+    {
+        std::vector<range> dirty;
+
+        if( n > 0 )
+        {
+            int m = k == 0? 1: static_cast<int>( next() % 4 );
+
+            for( int j = 0; j < m; ++j )
+            {
+                std::size_t offset = next() % n;
+                std::size_t size = next() % ( 3 * L );
+
+                if( size > n - offset ) size = n - offset;
+
+                for( std::size_t i = offset; i < offset + size; ++i )
+                {
+                    v[ i ] = static_cast<unsigned char>( next() );
+                }
+
+                range r = { offset, size };
+                dirty.push_back( r );
+            }
+
+            if( k == 1 )
+            {
+                // the last byte, in the last leaf, which may be incomplete
+
+                v[ n - 1 ] ^= 0x01;
+
+                range r = { n - 1, 1 };
+                dirty.push_back( r );
+            }
+        }
+
+        t1.rehash( v.data(), n, dirty );
+        t2.rehash( v.data(), n, dirty );
+        t3.rehash( v.data(), n, dirty, 3 );
+
+        typename H::result_type r0 = full_root<T>( v );
+
+        BOOST_TEST( t1.root() == r0 );
+        BOOST_TEST( t2.root() == r0 );
+        BOOST_TEST( t3.root() == r0 );
+    }
+
+    // the updated trees can still be appended to
+
+    v.insert( v.end(), data.begin(), data.begin() + L + 3 );
+
+    t1.update( v.data() + n, L + 3 );
+    t2.update( v.data() + n, L + 3 );
+
+    BOOST_TEST( t1.root() == full_root<T>( v ) );
+    BOOST_TEST( t2.root() == full_root<T>( v ) );
+}
+
+template<class H, std::size_t L> void test_save_load( std::size_t n )
+{
+    using T = boost::hash2::tree_hash<H, L>;
+    using range = typename T::range;
+
+    std::vector<unsigned char> v( data.begin(), data.begin() + n );
+
+    T t1;
+    t1.update( v.data(), n );
+
+    std::FILE* f = std::tmpfile();
+    BOOST_TEST( f != 0 );
+
+    if( f == 0 ) return;
+
+    BOOST_TEST( t1.save( f ) );
+
+    long size = std::ftell( f );
+
+    {
+        std::rewind( f );
+
+        T t2;
+
+        BOOST_TEST( t2.load( f ) );
+
+        BOOST_TEST_EQ( t2.size(), t1.size() );
+        BOOST_TEST_EQ( t2.leaf_count(), t1.leaf_count() );
+        BOOST_TEST( t2.root() == t1.root() );
+
+        for( std::size_t i = 0; i < t1.leaf_count(); ++i )
+        {
+            std::vector<typename T::proof_node> p1 = t1.proof( i );
+            std::vector<typename T::proof_node> p2 = t2.proof( i );
+
+            BOOST_TEST_EQ( p1.size(), p2.size() );
+
+            for( std::size_t j = 0; j < p1.size() && j < p2.size(); ++j )
+            {
+                BOOST_TEST( p1[ j ].digest == p2[ j ].digest );
+                BOOST_TEST_EQ( p1[ j ].left, p2[ j ].left );
+            }
+        }
+
+        // rehash after load, including the last leaf, then append
+
+        if( n > 0 )
+        {
+            v[ 0 ] ^= 0x80;
+            v[ n - 1 ] ^= 0x80;
+
+            std::vector<range> dirty;
+
+            range r1 = { 0, 1 };
+            range r2 = { n - 1, 1 };
+
+            dirty.push_back( r1 );
+            dirty.push_back( r2 );
+
+            t2.rehash( v.data(), n, dirty );
+
+            BOOST_TEST( t2.root() == full_root<T>( v ) );
+
+            v.push_back( 0x11 );
+            t2.update( v.data() + n, 1 );
+
+            BOOST_TEST( t2.root() == full_root<T>( v ) );
+        }
+    }
+
+    {
+        // appending directly after load, with the last leaf incomplete
+
+        std::rewind( f );
+
+        T t6;
+        BOOST_TEST( t6.load( f ) );
+
+        std::vector<unsigned char> v2( data.begin(), data.begin() + n );
+        v2.insert( v2.end(), data.begin(), data.begin() + L + 3 );
+
+        t6.update( v2.data() + n, 1 );
+        t6.update( v2.data() + n + 1, L + 2 );
+
+        BOOST_TEST( t6.root() == full_root<T>( v2 ) );
+
+        // the file ends after the bytes of the last leaf
+
+        BOOST_TEST_EQ( std::fgetc( f ), EOF );
+    }
+
+    {
+        // a different leaf size is rejected
+
+        std::rewind( f );
+
+        boost::hash2::tree_hash<H, L + 1> t3;
+        BOOST_TEST( !t3.load( f ) );
+    }
+
+    {
+        // a truncated file is rejected, and the tree is unchanged
+
+        std::rewind( f );
+
+        std::vector<unsigned char> w( static_cast<std::size_t>( size ) );
+        BOOST_TEST_EQ( std::fread( w.data(), 1, w.size(), f ), w.size() );
+
+        std::FILE* f2 = std::tmpfile();
+        BOOST_TEST( f2 != 0 );
+
+        if( f2 != 0 )
+        {
+            std::fwrite( w.data(), 1, w.size() - 1, f2 );
+            std::rewind( f2 );
+
+            T t4;
+            t4.update( data.data(), 7 );
+
+            BOOST_TEST( !t4.load( f2 ) );
+            BOOST_TEST_EQ( t4.size(), 7u );
+
+            std::fclose( f2 );
+        }
+
+        // so is a corrupted node, when there are upper levels
+
+        if( t1.leaf_count() > 1 )
+        {
+            w[ 32 ] ^= 0x01;
+
+            std::FILE* f3 = std::tmpfile();
+            BOOST_TEST( f3 != 0 );
+
+            if( f3 != 0 )
+            {
+                std::fwrite( w.data(), 1, w.size(), f3 );
+                std::rewind( f3 );
+
+                T t5;
+                BOOST_TEST( !t5.load( f3 ) );
+
+                std::fclose( f3 );
+            }
+
+            w[ 32 ] ^= 0x01;
+        }
+
+        // so is a corrupted byte of an incomplete last leaf
+
+        if( n % L != 0 )
+        {
+            w[ w.size() - 1 ] ^= 0x01;
+
+            std::FILE* f3 = std::tmpfile();
+            BOOST_TEST( f3 != 0 );
+
+            if( f3 != 0 )
+            {
+                std::fwrite( w.data(), 1, w.size(), f3 );
+                std::rewind( f3 );
+
+                T t5;
+                BOOST_TEST( !t5.load( f3 ) );
+
+                std::fclose( f3 );
+            }
+        }
+    }
+
+    std::fclose( f );
+}
+
+template<class H, std::size_t L> void test()
+{
+    std::size_t const sizes[] = { 0, 1, L - 1, L, L + 1, 2 * L, 3 * L + 5, 7 * L, 16 * L + 1, data.size() };
+
+    for( std::size_t k = 0; k < sizeof(sizes) / sizeof(sizes[0]); ++k )
+    {
+        std::size_t n = sizes[ k ];
+
+        if( n > data.size() ) continue;
+
+        test_rehash<H, L>( n );
+        test_save_load<H, L>( n );
+    }
+}
+
+// enough dirty leaves for them to be rehashed on several threads
+
+template<class H> void test_rehash_large()
+{
+    using T = boost::hash2::tree_hash<H, 1024>;
+    using range = typename T::range;
+
+    std::vector<unsigned char> v( ( 3 << 20 ) + 100 );
+
+    for( std::size_t i = 0; i < v.size(); ++i )
+    {
+        v[ i ] = static_cast<unsigned char>( next() );
+    }
+
+    T t1, t2;
+
+    t1.update( v.data(), v.size() );
+    t1.root();
+
+    t2.update( v.data(), v.size() );
+
+    std::vector<range> dirty;
+
+    dirty.push_back( range{ 1000, 2 << 20 } );
+    dirty.push_back( range{ v.size() - 50, 50 } );
+
+    for( std::size_t i = 0; i < dirty.size(); ++i )
+    {
+        for( std::size_t j = 0; j < dirty[ i ].size; ++j )
+        {
+            v[ dirty[ i ].offset + j ] ^= 0x5A;
+        }
+    }
+
+    t1.rehash( v.data(), v.size(), dirty, 4 );
+    t2.rehash( v.data(), v.size(), dirty, 0 );
+
+    typename T::result_type r = full_root<T>( v );
+
+    BOOST_TEST( t1.root() == r );
+    BOOST_TEST( t2.root() == r );
+}
+
+int main()
+{
+    for( std::size_t i = 0; i < data.size(); ++i )
+    {
+        data[ i ] = static_cast<unsigned char>( next() );
+    }
+
+    using namespace boost::hash2;
+
+    test<sha2_256, 64>();
+    test<md5_128, 100>();
+    test<xxhash_64, 32>();
+
+    test_rehash_large<sha2_256>();
+    test_rehash_large<xxhash_64>();
+
+    return boost::report_errors();
+}
@@ -0,0 +1,143 @@
+// Copyright 2024 Peter Dimov.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/hash2/update_buffers.hpp>
+#include <boost/hash2/fnv1a.hpp>
+#include <boost/hash2/xxhash.hpp>
+#include <boost/hash2/siphash.hpp>
+#include <boost/hash2/md5.hpp>
+#include <boost/hash2/sha1.hpp>
+#include <boost/hash2/sha2.hpp>
+#include <boost/hash2/ripemd.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <string>
+#include <vector>
+#include <list>
+#include <utility>
+#include <cstddef>
+#include <cstdint>
+
+struct iovec_like
+{
+    void* iov_base;
+    std::size_t iov_len;
+};
+
+struct const_buffer_like
+{
+    void const* p_;
+    std::size_t n_;
+
+    void const* data() const { return p_; }
+    std::size_t size() const { return n_; }
+};
+
+template<class H> void test( std::vector<unsigned char>& v, std::size_t step )
+{
+    H h0;
+    h0.update( v.data(), v.size() );
+
+    typename H::result_type r = h0.result();
+
+    std::vector<iovec_like> v1;
+    std::list<const_buffer_like> v2;
+    std::vector< std::pair<unsigned char const*, std::size_t> > v3;
+    std::vector< std::string > v4;
+
+    for( std::size_t i = 0; i < v.size(); i += step )
+    {
+        std::size_t n = v.size() - i < step? v.size() - i: step;
+
+        v1.push_back( { v.data() + i, n } );
+        v2.push_back( { v.data() + i, n } );
+        v3.push_back( { v.data() + i, n } );
+        v4.push_back( std::string( v.begin() + i, v.begin() + i + n ) );
+
+        // empty fragments
+        v1.push_back( { nullptr, 0 } );
+        v3.push_back( { nullptr, 0 } );
+        v4.push_back( std::string() );
+    }
+
+    {
+        H h;
+        boost::hash2::update_buffers( h, v1.begin(), v1.end() );
+
+        BOOST_TEST( h.result() == r );
+    }
+
+    {
+        H h;
+        boost::hash2::update_buffers( h, v2 );
+
+        BOOST_TEST( h.result() == r );
+    }
+
+    {
+        H h;
+        boost::hash2::update_buffers( h, v3 );
+
+        BOOST_TEST( h.result() == r );
+    }
+
+    {
+        H h;
+        boost::hash2::update_buffers( h, v4 );
+
+        BOOST_TEST( h.result() == r );
+    }
+
+    {
+        std::vector<std::uint32_t> w( v.size() / 4 );
+
+        H h1;
+        h1.update( w.data(), w.size() * 4 );
+
+        std::vector< std::vector<std::uint32_t> > w2;
+        w2.push_back( w );
+        w2.push_back( std::vector<std::uint32_t>() );
+
+        H h2;
+        boost::hash2::update_buffers( h2, w2 );
+
+        BOOST_TEST( h1.result() == h2.result() );
+    }
+}
+
+template<class H> void test()
+{
+    std::vector<unsigned char> v( 517 );
+
+    for( std::size_t i = 0; i < v.size(); ++i )
+    {
+        v[ i ] = static_cast<unsigned char>( i * 7 + 1 );
+    }
+
+    std::size_t const steps[] = { 1, 3, 8, 31, 64, 65, 200, 517, 1000 };
+
+    for( std::size_t i = 0; i < sizeof(steps) / sizeof(steps[0]); ++i )
+    {
+        test<H>( v, steps[ i ] );
+    }
+}
+
+int main()
+{
+    using namespace boost::hash2;
+
+    test<fnv1a_32>();
+    test<fnv1a_64>();
+    test<xxhash_32>();
+    test<xxhash_64>();
+    test<siphash_32>();
+    test<siphash_64>();
+    test<md5_128>();
+    test<sha1_160>();
+    test<sha2_256>();
+    test<sha2_512>();
+    test<ripemd_160>();
+    test<hmac_sha2_256>();
+
+    return boost::report_errors();
+}
@@ -0,0 +1,105 @@
+// Copyright 2024 Peter Dimov.
+// Distributed under the Boost Software License, Version 1.0.
+// https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/hash2/xxhash.hpp>
+#include <boost/hash2/siphash.hpp>
+#include <boost/hash2/sha2.hpp>
+#include <boost/hash2/fnv1a.hpp>
+#include <boost/hash2/md5.hpp>
+#include <boost/hash2/hash_append.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/core/lightweight_test_trait.hpp>
+#include <cstddef>
+#include <cstdint>
+
+unsigned char data[ 512 ];
+
+template<class H, std::size_t K> void test_size()
+{
+    for( std::size_t m = 0; m < 130; ++m )
+    {
+        H h1( 1 ), h2( 1 );
+
+        h1.update( data, m );
+        h2.update( data, m );
+
+        h1.update( data + m, K );
+        h2.template update<K>( data + m );
+
+        h1.update( data + 200, 5 );
+        h2.update( data + 200, 5 );
+
+        BOOST_TEST( h1.result() == h2.result() );
+    }
+}
+
+template<class H> void test()
+{
+    test_size<H, 0>();
+    test_size<H, 1>();
+    test_size<H, 3>();
+    test_size<H, 4>();
+    test_size<H, 7>();
+    test_size<H, 8>();
+    test_size<H, 9>();
+    test_size<H, 16>();
+    test_size<H, 17>();
+    test_size<H, 32>();
+    test_size<H, 33>();
+    test_size<H, 64>();
+    test_size<H, 65>();
+    test_size<H, 128>();
+    test_size<H, 200>();
+}
+
+int main()
+{
+    for( std::size_t i = 0; i < sizeof(data); ++i )
+    {
+        data[ i ] = static_cast<unsigned char>( i * 0x9D + 0x3B );
+    }
+
+    using namespace boost::hash2;
+
+    test<xxhash_32>();
+    test<xxhash_64>();
+    test<siphash_32>();
+    test<siphash_64>();
+    test<sha2_224>();
+    test<sha2_256>();
+    test<sha2_384>();
+    test<sha2_512>();
+    test<sha2_512_224>();
+    test<sha2_512_256>();
+
+    BOOST_TEST_TRAIT_TRUE((detail::has_fixed_update<xxhash_64, 8>));
+    BOOST_TEST_TRAIT_TRUE((detail::has_fixed_update<siphash_64, 16>));
+    BOOST_TEST_TRAIT_TRUE((detail::has_fixed_update<sha2_256, 32>));
+    BOOST_TEST_TRAIT_FALSE((detail::has_fixed_update<fnv1a_64, 8>));
+    BOOST_TEST_TRAIT_FALSE((detail::has_fixed_update<md5_128, 8>));
+
+    // hash_append of fixed size values goes through update<N>
+
+    {
+        std::uint64_t v = 0x0102030405060708ull;
+
+        siphash_64 h1, h2;
+
+        hash_append( h1, {}, v );
+        hash_append( h1, big_endian_flavor(), v );
+
+        unsigned char w[ 16 ] = { 8, 7, 6, 5, 4, 3, 2, 1, 1, 2, 3, 4, 5, 6, 7, 8 };
+
+        if( endian::native == endian::big )
+        {
+            for( int i = 0; i < 8; ++i ) w[ i ] = w[ 15 - i ];
+        }
+
+        h2.update( w, 16 );
+
+        BOOST_TEST_EQ( h1.result(), h2.result() );
+    }
+
+    return boost::report_errors();
+}